@@ -0,0 +1,218 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Ivan Denkovski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Board.h"
+
+#if _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "FairyPieces.h"
+#include "OrthodoxPieces.h"
+#include "Zobrist.h"
+
+namespace moderato {
+
+namespace {
+
+const King whiteKing(false);
+const King blackKing(true);
+const Queen whiteQueen(false);
+const Queen blackQueen(true);
+const Rook whiteRook(false);
+const Rook blackRook(true);
+const Bishop whiteBishop(false);
+const Bishop blackBishop(true);
+const Knight whiteKnight(false);
+const Knight blackKnight(true);
+const Pawn whitePawn(false);
+const Pawn blackPawn(true);
+const Grasshopper whiteGrasshopper(false);
+const Grasshopper blackGrasshopper(true);
+const Nightrider whiteNightrider(false);
+const Nightrider blackNightrider(true);
+const Amazon whiteAmazon(false);
+const Amazon blackAmazon(true);
+
+const Piece* const pieces[] = {
+    nullptr,           nullptr,          &whiteKing,        &blackKing,
+    &whiteQueen,       &blackQueen,      &whiteRook,        &blackRook,
+    &whiteBishop,      &blackBishop,     &whiteKnight,      &blackKnight,
+    &whitePawn,        &blackPawn,       &whiteGrasshopper, &blackGrasshopper,
+    &whiteNightrider,  &blackNightrider, &whiteAmazon,      &blackAmazon};
+
+int findLowest(std::uint64_t bits) {
+#if _MSC_VER
+  unsigned long index;
+  if (_BitScanForward(&index, static_cast<unsigned long>(bits))) {
+    return static_cast<int>(index);
+  }
+  _BitScanForward(&index, static_cast<unsigned long>(bits >> 32));
+  return static_cast<int>(index) + 32;
+#else
+  return __builtin_ctzll(bits);
+#endif
+}
+
+}  // namespace
+
+unsigned char Board::toCode(int type, bool black) {
+  return static_cast<unsigned char>(type << 1 | black);
+}
+bool Board::isBlack(unsigned char code) { return code & 1; }
+const Piece& Board::toPiece(unsigned char code) { return *pieces[code]; }
+int Board::toCastling(int square) {
+  switch (square) {
+    case 0:
+      return 1;
+    case 7:
+      return 2;
+    case 64:
+      return 4;
+    case 71:
+      return 8;
+    case 112:
+      return 16;
+    case 119:
+      return 32;
+    default:
+      return 0;
+  }
+}
+unsigned char Board::at(int square) const { return codes_[square]; }
+const Piece& Board::getPiece(int square) const {
+  return *pieces[codes_[square]];
+}
+int Board::findFirst(bool black) const { return findNext(black, -1); }
+int Board::findNext(bool black, int square) const {
+  int start = square + 1;
+  for (int word = start / 64; word < 2; word++) {
+    std::uint64_t bits = occupancies_[black][word];
+    if (word == start / 64) {
+      bits &= ~std::uint64_t() << start % 64;
+    }
+    if (bits) {
+      return word * 64 + findLowest(bits);
+    }
+  }
+  return 128;
+}
+int Board::getRoyal(bool black) const { return royals_[black]; }
+void Board::findLines(int square, bool black, bool all,
+                      std::array<bool, 128>& lines) const {
+  for (int direction : {-17, -16, -15, -1, 1, 15, 16, 17}) {
+    bool orthogonal = direction == -16 || direction == -1 || direction == 1 ||
+                      direction == 16;
+    bool open = all;
+    for (int next = square + direction; !(next & 136) && !open;
+         next += direction) {
+      unsigned char code = codes_[next];
+      open = code == toCode(QUEEN, black) ||
+             code == toCode(orthogonal ? ROOK : BISHOP, black) ||
+             code == toCode(AMAZON, black) ||
+             code == toCode(GRASSHOPPER, black);
+    }
+    if (open) {
+      for (int next = square + direction; !(next & 136); next += direction) {
+        lines[next] = true;
+      }
+    }
+  }
+  for (int direction : {-33, -31, -18, -14, 14, 18, 31, 33}) {
+    bool open = all;
+    for (int next = square + direction; !(next & 136) && !open;
+         next += direction) {
+      open = codes_[next] == toCode(NIGHTRIDER, black);
+    }
+    if (open) {
+      for (int next = square + direction; !(next & 136); next += direction) {
+        lines[next] = true;
+      }
+    }
+  }
+}
+std::uint64_t Board::getKey() const { return key_; }
+void Board::occupy(int square, unsigned char code) {
+  codes_[square] = code;
+  occupancies_[isBlack(code)][square / 64] |= std::uint64_t(1) << square % 64;
+  key_ ^= hashPiece(code, square);
+  if (toPiece(code).isRoyal()) {
+    royals_[isBlack(code)] = square;
+  }
+}
+void Board::vacate(int square, unsigned char code) {
+  codes_[square] = 0;
+  occupancies_[isBlack(code)][square / 64] &=
+      ~(std::uint64_t(1) << square % 64);
+  key_ ^= hashPiece(code, square);
+  if (toPiece(code).isRoyal() && royals_[isBlack(code)] == square) {
+    royals_[isBlack(code)] = -1;
+  }
+}
+void Board::place(int square, unsigned char code) {
+  if (code) {
+    if (codes_[square]) {
+      vacate(square, codes_[square]);
+    }
+    occupy(square, code);
+  }
+}
+unsigned char Board::remove(int square) {
+  unsigned char code = codes_[square];
+  if (code) {
+    vacate(square, code);
+  }
+  return code;
+}
+void Board::move(int origin, int target) {
+  unsigned char code = codes_[origin];
+  if (code && origin != target) {
+    vacate(origin, code);
+    occupy(target, code);
+  }
+}
+void Board::changeColour(int square) {
+  unsigned char code = codes_[square];
+  if (code) {
+    vacate(square, code);
+    occupy(square, static_cast<unsigned char>(code ^ 1));
+  }
+}
+std::ostream& operator<<(std::ostream& output, const Board& board) {
+  output << "[";
+  for (auto code = board.codes_.cbegin(); code != board.codes_.cend();
+       code++) {
+    if (code != board.codes_.cbegin()) {
+      output << ", ";
+    }
+    output << "*";
+    if (*code) {
+      output << Board::toPiece(*code);
+    }
+  }
+  output << "]";
+  return output;
+}
+
+}  // namespace moderato
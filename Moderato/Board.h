@@ -0,0 +1,72 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Ivan Denkovski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "Piece.h"
+
+namespace moderato {
+
+class Board {
+  std::array<unsigned char, 128> codes_ = {};
+  std::array<std::array<std::uint64_t, 2>, 2> occupancies_ = {};
+  std::array<int, 2> royals_ = {{-1, -1}};
+  std::uint64_t key_ = 0;
+  void occupy(int square, unsigned char code);
+  void vacate(int square, unsigned char code);
+
+ public:
+  enum {
+    KING = 1,
+    QUEEN,
+    ROOK,
+    BISHOP,
+    KNIGHT,
+    PAWN,
+    GRASSHOPPER,
+    NIGHTRIDER,
+    AMAZON
+  };
+  static unsigned char toCode(int type, bool black);
+  static bool isBlack(unsigned char code);
+  static const Piece& toPiece(unsigned char code);
+  static int toCastling(int square);
+  unsigned char at(int square) const;
+  const Piece& getPiece(int square) const;
+  int findFirst(bool black) const;
+  int findNext(bool black, int square) const;
+  int getRoyal(bool black) const;
+  void findLines(int square, bool black, bool all,
+                 std::array<bool, 128>& lines) const;
+  std::uint64_t getKey() const;
+  void place(int square, unsigned char code);
+  unsigned char remove(int square);
+  void move(int origin, int target);
+  void changeColour(int square);
+  friend std::ostream& operator<<(std::ostream& output, const Board& board);
+};
+
+}  // namespace moderato
@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Ivan Denkovski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "CheckInfo.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace moderato {
+
+CheckInfo::CheckInfo(const Board& board, bool black,
+                     const MoveFactory& moveFactory)
+    : board_(board),
+      black_(black),
+      royal_(board.getRoyal(!black)),
+      localChecks_(moveFactory.hasLocalChecks()),
+      lines_() {
+  if (royal_ >= 0 && localChecks_) {
+    board_.findLines(royal_, black_, false, lines_);
+  }
+}
+bool CheckInfo::isClear(int origin, int first, int last, int step) const {
+  for (int square = first + step; square != last; square += step) {
+    if (board_.at(square) && square != origin) {
+      return false;
+    }
+  }
+  return true;
+}
+bool CheckInfo::mayGiveCheck(const Move& move) const {
+  if (royal_ < 0) {
+    return false;
+  }
+  int kind = move.getKind();
+  if (!localChecks_ ||
+      !(kind == Move::QUIET_MOVE || kind == Move::CAPTURE ||
+        kind == Move::DOUBLE_STEP)) {
+    return true;
+  }
+  int origin = move.getOrigin();
+  int target = move.getTarget();
+  if (lines_[origin] || lines_[target]) {
+    return true;
+  }
+  int files = royal_ / 16 - target / 16;
+  int ranks = royal_ % 16 - target % 16;
+  int distance = std::max(std::abs(files), std::abs(ranks));
+  bool orthogonal = files == 0 || ranks == 0;
+  bool diagonal = std::abs(files) == std::abs(ranks);
+  bool oblique = std::abs(files * ranks) == 2;
+  int step =
+      orthogonal || diagonal ? files / distance * 16 + ranks / distance : 0;
+  switch (board_.at(origin) >> 1) {
+    case Board::KING:
+      return distance == 1;
+    case Board::QUEEN:
+      return (orthogonal || diagonal) && isClear(origin, target, royal_, step);
+    case Board::ROOK:
+      return orthogonal && isClear(origin, target, royal_, step);
+    case Board::BISHOP:
+      return diagonal && isClear(origin, target, royal_, step);
+    case Board::KNIGHT:
+      return oblique;
+    case Board::PAWN:
+      return std::abs(files) == 1 && ranks == (black_ ? -1 : 1);
+    case Board::GRASSHOPPER:
+      if (orthogonal || diagonal) {
+        int hurdle = royal_ - step;
+        return hurdle != target && hurdle != origin && board_.at(hurdle) &&
+               isClear(origin, target, hurdle, step);
+      }
+      return false;
+    case Board::NIGHTRIDER: {
+      int length = std::min(std::abs(files), std::abs(ranks));
+      if (!length || std::max(std::abs(files), std::abs(ranks)) != 2 * length) {
+        return false;
+      }
+      return isClear(origin, target, royal_,
+                     files / length * 16 + ranks / length);
+    }
+    case Board::AMAZON:
+      return oblique || ((orthogonal || diagonal) &&
+                         isClear(origin, target, royal_, step));
+    default:
+      return true;
+  }
+}
+
+}  // namespace moderato
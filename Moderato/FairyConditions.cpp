@@ -31,81 +31,69 @@ namespace moderato {
 void NoCaptureMoveFactory::write(std::ostream& output) const {
   output << "NoCaptureMoveFactory[]";
 }
-bool NoCaptureMoveFactory::generateCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, std::vector<std::unique_ptr<Move>>& moves) const {
-  return !board.at(target)->isRoyal();
+bool NoCaptureMoveFactory::generateCapture(const Board& board, int origin,
+                                           int target, MoveList& moves) const {
+  return !board.getPiece(target).isRoyal();
 }
-bool NoCaptureMoveFactory::generateEnPassant(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop, std::vector<std::unique_ptr<Move>>& moves) const {
-  return !board.at(stop)->isRoyal();
+bool NoCaptureMoveFactory::generateEnPassant(const Board& board, int origin,
+                                             int target, int stop,
+                                             MoveList& moves) const {
+  return !board.getPiece(stop).isRoyal();
 }
 bool NoCaptureMoveFactory::generatePromotionCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  return !board.at(target)->isRoyal();
+    const Board& board, int origin, int target, bool black, int type,
+    MoveList& moves) const {
+  return !board.getPiece(target).isRoyal();
 }
 
 void CirceMoveFactory::write(std::ostream& output) const {
   output << "CirceMoveFactory[]";
 }
-bool CirceMoveFactory::generateCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::unique_ptr<Piece>& piece = board.at(target);
-  if (piece->isRoyal()) {
+bool CirceMoveFactory::generateCapture(const Board& board, int origin,
+                                       int target, MoveList& moves) const {
+  const Piece& piece = board.getPiece(target);
+  if (piece.isRoyal()) {
     return false;
   }
-  int rebirth = piece->findRebirthSquare(board, target, false);
+  int rebirth = piece.findRebirthSquare(board, target, false);
   if (!board.at(rebirth) || rebirth == origin) {
-    bool castling = piece->isCastling();
-    moves.push_back(
-        std::make_unique<CirceCapture>(origin, target, rebirth, castling));
+    bool castling = piece.isCastling();
+    moves.add(CirceCapture(origin, target, rebirth, castling));
   } else {
-    moves.push_back(std::make_unique<Capture>(origin, target));
+    moves.add(Capture(origin, target));
   }
   return true;
 }
-bool CirceMoveFactory::generateEnPassant(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop, std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::unique_ptr<Piece>& piece = board.at(stop);
-  if (piece->isRoyal()) {
+bool CirceMoveFactory::generateEnPassant(const Board& board, int origin,
+                                         int target, int stop,
+                                         MoveList& moves) const {
+  const Piece& piece = board.getPiece(stop);
+  if (piece.isRoyal()) {
     return false;
   }
-  int rebirth = piece->findRebirthSquare(board, stop, false);
+  int rebirth = piece.findRebirthSquare(board, stop, false);
   if ((!board.at(rebirth) || rebirth == origin || rebirth == stop) &&
       !(rebirth == target)) {
-    bool castling = piece->isCastling();
-    moves.push_back(std::make_unique<CirceEnPassant>(origin, target, stop,
-                                                     rebirth, castling));
+    bool castling = piece.isCastling();
+    moves.add(CirceEnPassant(origin, target, rebirth, castling));
   } else {
-    moves.push_back(std::make_unique<EnPassant>(origin, target, stop));
+    moves.add(EnPassant(origin, target));
   }
   return true;
 }
 bool CirceMoveFactory::generatePromotionCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::unique_ptr<Piece>& piece = board.at(target);
-  if (piece->isRoyal()) {
+    const Board& board, int origin, int target, bool black, int type,
+    MoveList& moves) const {
+  const Piece& piece = board.getPiece(target);
+  if (piece.isRoyal()) {
     return false;
   }
-  int rebirth = piece->findRebirthSquare(board, target, false);
+  int rebirth = piece.findRebirthSquare(board, target, false);
   if (!board.at(rebirth) || rebirth == origin) {
-    bool castling = piece->isCastling();
-    moves.push_back(std::make_unique<CircePromotionCapture>(
-        origin, target, black, order, rebirth, castling));
+    bool castling = piece.isCastling();
+    moves.add(CircePromotionCapture(origin, target, type, rebirth, castling));
   } else {
-    moves.push_back(
-        std::make_unique<PromotionCapture>(origin, target, black, order));
+    moves.add(PromotionCapture(origin, target, type));
   }
   return true;
 }
@@ -114,89 +102,66 @@ AntiCirceMoveFactory::AntiCirceMoveFactory(bool calvet) : calvet_(calvet) {}
 void AntiCirceMoveFactory::write(std::ostream& output) const {
   output << "AntiCirceMoveFactory[calvet=" << calvet_ << "]";
 }
-bool AntiCirceMoveFactory::generateCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::unique_ptr<Piece>& piece = board.at(origin);
-  int rebirth = piece->findRebirthSquare(board, target, false);
+bool AntiCirceMoveFactory::generateCapture(const Board& board, int origin,
+                                           int target, MoveList& moves) const {
+  const Piece& piece = board.getPiece(origin);
+  int rebirth = piece.findRebirthSquare(board, target, false);
   if (!board.at(rebirth) || rebirth == origin || calvet_ && rebirth == target) {
-    if (board.at(target)->isRoyal()) {
+    if (board.getPiece(target).isRoyal()) {
       return false;
     }
-    bool castling = piece->isCastling();
-    moves.push_back(
-        std::make_unique<AntiCirceCapture>(origin, target, rebirth, castling));
+    bool castling = piece.isCastling();
+    moves.add(AntiCirceCapture(origin, target, rebirth, castling));
   }
   return true;
 }
-bool AntiCirceMoveFactory::generateCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target) const {
-  const std::unique_ptr<Piece>& piece = board.at(origin);
-  int rebirth = piece->findRebirthSquare(board, target, false);
+bool AntiCirceMoveFactory::generateCapture(const Board& board, int origin,
+                                           int target) const {
+  const Piece& piece = board.getPiece(origin);
+  int rebirth = piece.findRebirthSquare(board, target, false);
   if (!board.at(rebirth) || rebirth == origin || calvet_ && rebirth == target) {
-    if (board.at(target)->isRoyal()) {
+    if (board.getPiece(target).isRoyal()) {
       return false;
     }
   }
   return true;
 }
-bool AntiCirceMoveFactory::generateEnPassant(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop, std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::unique_ptr<Piece>& piece = board.at(origin);
-  int rebirth = piece->findRebirthSquare(board, target, false);
+bool AntiCirceMoveFactory::generateEnPassant(const Board& board, int origin,
+                                             int target, int stop,
+                                             MoveList& moves) const {
+  const Piece& piece = board.getPiece(origin);
+  int rebirth = piece.findRebirthSquare(board, target, false);
   if ((!board.at(rebirth) || rebirth == origin || rebirth == stop) &&
       (calvet_ || !(rebirth == target))) {
-    if (board.at(stop)->isRoyal()) {
-      return false;
-    }
-    bool castling = piece->isCastling();
-    moves.push_back(std::make_unique<AntiCirceEnPassant>(origin, target, stop,
-                                                         rebirth, castling));
-  }
-  return true;
-}
-bool AntiCirceMoveFactory::generateEnPassant(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop) const {
-  const std::unique_ptr<Piece>& piece = board.at(origin);
-  int rebirth = piece->findRebirthSquare(board, target, false);
-  if ((!board.at(rebirth) || rebirth == origin || rebirth == stop) &&
-      (calvet_ || !(rebirth == target))) {
-    if (board.at(stop)->isRoyal()) {
+    if (board.getPiece(stop).isRoyal()) {
       return false;
     }
+    bool castling = piece.isCastling();
+    moves.add(AntiCirceEnPassant(origin, target, rebirth, castling));
   }
   return true;
 }
 bool AntiCirceMoveFactory::generatePromotionCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::unique_ptr<Piece>& piece = box.at(black).at(order).front();
-  int rebirth = piece->findRebirthSquare(board, target, false);
+    const Board& board, int origin, int target, bool black, int type,
+    MoveList& moves) const {
+  const Piece& piece = Board::toPiece(Board::toCode(type, black));
+  int rebirth = piece.findRebirthSquare(board, target, false);
   if (!board.at(rebirth) || rebirth == origin || calvet_ && rebirth == target) {
-    if (board.at(target)->isRoyal()) {
+    if (board.getPiece(target).isRoyal()) {
       return false;
     }
-    bool castling = piece->isCastling();
-    moves.push_back(std::make_unique<AntiCircePromotionCapture>(
-        origin, target, black, order, rebirth, castling));
+    bool castling = piece.isCastling();
+    moves.add(AntiCircePromotionCapture(origin, target, type, rebirth,
+                                        castling));
   }
   return true;
 }
 bool AntiCirceMoveFactory::generatePromotionCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order) const {
-  const std::unique_ptr<Piece>& piece = box.at(black).at(order).front();
-  int rebirth = piece->findRebirthSquare(board, target, false);
+    const Board& board, int origin, int target, bool black, int type) const {
+  const Piece& piece = Board::toPiece(Board::toCode(type, black));
+  int rebirth = piece.findRebirthSquare(board, target, false);
   if (!board.at(rebirth) || rebirth == origin || calvet_ && rebirth == target) {
-    if (board.at(target)->isRoyal()) {
+    if (board.getPiece(target).isRoyal()) {
       return false;
     }
   }
@@ -206,58 +171,50 @@ bool AntiCirceMoveFactory::generatePromotionCapture(
 void AndernachMoveFactory::write(std::ostream& output) const {
   output << "AndernachMoveFactory[]";
 }
-bool AndernachMoveFactory::generateCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, std::vector<std::unique_ptr<Move>>& moves) const {
-  if (board.at(target)->isRoyal()) {
+bool AndernachMoveFactory::generateCapture(const Board& board, int origin,
+                                           int target, MoveList& moves) const {
+  if (board.getPiece(target).isRoyal()) {
     return false;
   }
-  const std::unique_ptr<Piece>& piece = board.at(origin);
-  if (!piece->isRoyal()) {
-    bool castling = piece->isCastling() &&
-                    piece->findRebirthSquare(board, target, true) == target;
-    moves.push_back(
-        std::make_unique<AndernachCapture>(origin, target, castling));
+  const Piece& piece = board.getPiece(origin);
+  if (!piece.isRoyal()) {
+    bool castling = piece.isCastling() &&
+                    piece.findRebirthSquare(board, target, true) == target;
+    moves.add(AndernachCapture(origin, target, castling));
   } else {
-    moves.push_back(std::make_unique<Capture>(origin, target));
+    moves.add(Capture(origin, target));
   }
   return true;
 }
-bool AndernachMoveFactory::generateEnPassant(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop, std::vector<std::unique_ptr<Move>>& moves) const {
-  if (board.at(stop)->isRoyal()) {
+bool AndernachMoveFactory::generateEnPassant(const Board& board, int origin,
+                                             int target, int stop,
+                                             MoveList& moves) const {
+  if (board.getPiece(stop).isRoyal()) {
     return false;
   }
-  const std::unique_ptr<Piece>& piece = board.at(origin);
-  if (!piece->isRoyal()) {
-    bool castling = piece->isCastling() &&
-                    piece->findRebirthSquare(board, target, true) == target;
-    moves.push_back(
-        std::make_unique<AndernachEnPassant>(origin, target, stop, castling));
+  const Piece& piece = board.getPiece(origin);
+  if (!piece.isRoyal()) {
+    bool castling = piece.isCastling() &&
+                    piece.findRebirthSquare(board, target, true) == target;
+    moves.add(AndernachEnPassant(origin, target, castling));
   } else {
-    moves.push_back(std::make_unique<EnPassant>(origin, target, stop));
+    moves.add(EnPassant(origin, target));
   }
   return true;
 }
 bool AndernachMoveFactory::generatePromotionCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  if (board.at(target)->isRoyal()) {
+    const Board& board, int origin, int target, bool black, int type,
+    MoveList& moves) const {
+  if (board.getPiece(target).isRoyal()) {
     return false;
   }
-  const std::unique_ptr<Piece>& piece = box.at(black).at(order).front();
-  if (!piece->isRoyal()) {
-    bool castling = piece->isCastling() &&
-                    piece->findRebirthSquare(board, target, true) == target;
-    moves.push_back(std::make_unique<AndernachPromotionCapture>(
-        origin, target, black, order, castling));
+  const Piece& piece = Board::toPiece(Board::toCode(type, black));
+  if (!piece.isRoyal()) {
+    bool castling = piece.isCastling() &&
+                    piece.findRebirthSquare(board, target, true) == target;
+    moves.add(AndernachPromotionCapture(origin, target, type, castling));
   } else {
-    moves.push_back(
-        std::make_unique<PromotionCapture>(origin, target, black, order));
+    moves.add(PromotionCapture(origin, target, type));
   }
   return true;
 }
@@ -266,45 +223,38 @@ void AntiAndernachMoveFactory::write(std::ostream& output) const {
   output << "AntiAndernachMoveFactory[]";
 }
 void AntiAndernachMoveFactory::generateQuietMove(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::unique_ptr<Piece>& piece = board.at(origin);
-  if (!piece->isRoyal()) {
-    bool castling = piece->isCastling() &&
-                    piece->findRebirthSquare(board, target, true) == target;
-    moves.push_back(
-        std::make_unique<AntiAndernachQuietMove>(origin, target, castling));
+    const Board& board, int origin, int target, MoveList& moves) const {
+  const Piece& piece = board.getPiece(origin);
+  if (!piece.isRoyal()) {
+    bool castling = piece.isCastling() &&
+                    piece.findRebirthSquare(board, target, true) == target;
+    moves.add(AntiAndernachQuietMove(origin, target, castling));
   } else {
-    moves.push_back(std::make_unique<QuietMove>(origin, target));
+    moves.add(QuietMove(origin, target));
   }
 }
 void AntiAndernachMoveFactory::generateDoubleStep(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop, std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::unique_ptr<Piece>& piece = board.at(origin);
-  if (!piece->isRoyal()) {
-    bool castling = piece->isCastling() &&
-                    piece->findRebirthSquare(board, target, true) == target;
-    moves.push_back(
-        std::make_unique<AntiAndernachQuietMove>(origin, target, castling));
+    const Board& board, int origin, int target, int stop,
+    MoveList& moves) const {
+  const Piece& piece = board.getPiece(origin);
+  if (!piece.isRoyal()) {
+    bool castling = piece.isCastling() &&
+                    piece.findRebirthSquare(board, target, true) == target;
+    moves.add(AntiAndernachQuietMove(origin, target, castling));
   } else {
-    moves.push_back(std::make_unique<DoubleStep>(origin, target, stop));
+    moves.add(DoubleStep(origin, target));
   }
 }
 void AntiAndernachMoveFactory::generatePromotion(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::unique_ptr<Piece>& piece = box.at(black).at(order).front();
-  if (!piece->isRoyal()) {
-    bool castling = piece->isCastling() &&
-                    piece->findRebirthSquare(board, target, true) == target;
-    moves.push_back(std::make_unique<AntiAndernachPromotion>(
-        origin, target, black, order, castling));
+    const Board& board, int origin, int target, bool black, int type,
+    MoveList& moves) const {
+  const Piece& piece = Board::toPiece(Board::toCode(type, black));
+  if (!piece.isRoyal()) {
+    bool castling = piece.isCastling() &&
+                    piece.findRebirthSquare(board, target, true) == target;
+    moves.add(AntiAndernachPromotion(origin, target, type, castling));
   } else {
-    moves.push_back(std::make_unique<Promotion>(origin, target, black, order));
+    moves.add(Promotion(origin, target, type));
   }
 }
 
@@ -312,102 +262,91 @@ void CirceAndernachMoveFactory::write(std::ostream& output) const {
   output << "CirceAndernachMoveFactory[]";
 }
 bool CirceAndernachMoveFactory::generateCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::unique_ptr<Piece>& piece = board.at(target);
-  if (piece->isRoyal()) {
+    const Board& board, int origin, int target, MoveList& moves) const {
+  const Piece& piece = board.getPiece(target);
+  if (piece.isRoyal()) {
     return false;
   }
-  int rebirth = piece->findRebirthSquare(board, target, false);
-  const std::unique_ptr<Piece>& piece2 = board.at(origin);
+  int rebirth = piece.findRebirthSquare(board, target, false);
+  const Piece& piece2 = board.getPiece(origin);
   if (!board.at(rebirth) || rebirth == origin) {
-    bool castling = piece->isCastling();
-    if (!piece2->isRoyal()) {
-      bool castling2 = piece2->isCastling() &&
-                       piece2->findRebirthSquare(board, target, true) == target;
-      moves.push_back(std::make_unique<CirceAndernachCapture>(
-          origin, target, rebirth, castling, castling2));
+    bool castling = piece.isCastling();
+    if (!piece2.isRoyal()) {
+      bool castling2 = piece2.isCastling() &&
+                       piece2.findRebirthSquare(board, target, true) == target;
+      moves.add(CirceAndernachCapture(origin, target, rebirth, castling,
+                                      castling2));
     } else {
-      moves.push_back(
-          std::make_unique<CirceCapture>(origin, target, rebirth, castling));
+      moves.add(CirceCapture(origin, target, rebirth, castling));
     }
   } else {
-    if (!piece2->isRoyal()) {
-      bool castling = piece2->isCastling() &&
-                      piece2->findRebirthSquare(board, target, true) == target;
-      moves.push_back(
-          std::make_unique<AndernachCapture>(origin, target, castling));
+    if (!piece2.isRoyal()) {
+      bool castling = piece2.isCastling() &&
+                      piece2.findRebirthSquare(board, target, true) == target;
+      moves.add(AndernachCapture(origin, target, castling));
     } else {
-      moves.push_back(std::make_unique<Capture>(origin, target));
+      moves.add(Capture(origin, target));
     }
   }
   return true;
 }
 bool CirceAndernachMoveFactory::generateEnPassant(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop, std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::unique_ptr<Piece>& piece = board.at(stop);
-  if (piece->isRoyal()) {
+    const Board& board, int origin, int target, int stop,
+    MoveList& moves) const {
+  const Piece& piece = board.getPiece(stop);
+  if (piece.isRoyal()) {
     return false;
   }
-  int rebirth = piece->findRebirthSquare(board, stop, false);
-  const std::unique_ptr<Piece>& piece2 = board.at(origin);
+  int rebirth = piece.findRebirthSquare(board, stop, false);
+  const Piece& piece2 = board.getPiece(origin);
   if ((!board.at(rebirth) || rebirth == origin || rebirth == stop) &&
       !(rebirth == target)) {
-    bool castling = piece->isCastling();
-    if (!piece2->isRoyal()) {
-      bool castling2 = piece2->isCastling() &&
-                       piece2->findRebirthSquare(board, target, true) == target;
-      moves.push_back(std::make_unique<CirceAndernachEnPassant>(
-          origin, target, stop, rebirth, castling, castling2));
+    bool castling = piece.isCastling();
+    if (!piece2.isRoyal()) {
+      bool castling2 = piece2.isCastling() &&
+                       piece2.findRebirthSquare(board, target, true) == target;
+      moves.add(CirceAndernachEnPassant(origin, target, rebirth, castling,
+                                        castling2));
     } else {
-      moves.push_back(std::make_unique<CirceEnPassant>(origin, target, stop,
-                                                       rebirth, castling));
+      moves.add(CirceEnPassant(origin, target, rebirth, castling));
     }
   } else {
-    if (!piece2->isRoyal()) {
-      bool castling = piece2->isCastling() &&
-                      piece2->findRebirthSquare(board, target, true) == target;
-      moves.push_back(
-          std::make_unique<AndernachEnPassant>(origin, target, stop, castling));
+    if (!piece2.isRoyal()) {
+      bool castling = piece2.isCastling() &&
+                      piece2.findRebirthSquare(board, target, true) == target;
+      moves.add(AndernachEnPassant(origin, target, castling));
     } else {
-      moves.push_back(std::make_unique<EnPassant>(origin, target, stop));
+      moves.add(EnPassant(origin, target));
     }
   }
   return true;
 }
 bool CirceAndernachMoveFactory::generatePromotionCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::unique_ptr<Piece>& piece = board.at(target);
-  if (piece->isRoyal()) {
+    const Board& board, int origin, int target, bool black, int type,
+    MoveList& moves) const {
+  const Piece& piece = board.getPiece(target);
+  if (piece.isRoyal()) {
     return false;
   }
-  int rebirth = piece->findRebirthSquare(board, target, false);
-  const std::unique_ptr<Piece>& piece2 = box.at(black).at(order).front();
+  int rebirth = piece.findRebirthSquare(board, target, false);
+  const Piece& piece2 = Board::toPiece(Board::toCode(type, black));
   if (!board.at(rebirth) || rebirth == origin) {
-    bool castling = piece->isCastling();
-    if (!piece2->isRoyal()) {
-      bool castling2 = piece2->isCastling() &&
-                       piece2->findRebirthSquare(board, target, true) == target;
-      moves.push_back(std::make_unique<CirceAndernachPromotionCapture>(
-          origin, target, black, order, rebirth, castling, castling2));
+    bool castling = piece.isCastling();
+    if (!piece2.isRoyal()) {
+      bool castling2 = piece2.isCastling() &&
+                       piece2.findRebirthSquare(board, target, true) == target;
+      moves.add(CirceAndernachPromotionCapture(origin, target, type, rebirth,
+                                               castling, castling2));
     } else {
-      moves.push_back(std::make_unique<CircePromotionCapture>(
-          origin, target, black, order, rebirth, castling));
+      moves.add(CircePromotionCapture(origin, target, type, rebirth, castling));
     }
   } else {
-    if (!piece2->isRoyal()) {
-      bool castling = piece2->isCastling() &&
-                      piece2->findRebirthSquare(board, target, true) == target;
-      moves.push_back(std::make_unique<AndernachPromotionCapture>(
-          origin, target, black, order, castling));
+    if (!piece2.isRoyal()) {
+      bool castling = piece2.isCastling() &&
+                      piece2.findRebirthSquare(board, target, true) == target;
+      moves.add(AndernachPromotionCapture(origin, target, type, castling));
     } else {
-      moves.push_back(
-          std::make_unique<PromotionCapture>(origin, target, black, order));
+      moves.add(PromotionCapture(origin, target, type));
     }
   }
   return true;
@@ -419,180 +358,147 @@ void AntiCirceAndernachMoveFactory::write(std::ostream& output) const {
   output << "AntiCirceAndernachMoveFactory[calvet=" << calvet_ << "]";
 }
 bool AntiCirceAndernachMoveFactory::generateCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::unique_ptr<Piece>& piece = board.at(origin);
-  int rebirth = piece->findRebirthSquare(board, target, false);
+    const Board& board, int origin, int target, MoveList& moves) const {
+  const Piece& piece = board.getPiece(origin);
+  int rebirth = piece.findRebirthSquare(board, target, false);
   if (!board.at(rebirth) || rebirth == origin || calvet_ && rebirth == target) {
-    if (board.at(target)->isRoyal()) {
+    if (board.getPiece(target).isRoyal()) {
       return false;
     }
-    if (!piece->isRoyal()) {
-      bool castling = piece->isCastling() &&
-                      piece->findRebirthSquare(board, rebirth, true) == rebirth;
-      moves.push_back(std::make_unique<AntiCirceAndernachCapture>(
-          origin, target, rebirth, castling));
+    if (!piece.isRoyal()) {
+      bool castling = piece.isCastling() &&
+                      piece.findRebirthSquare(board, rebirth, true) == rebirth;
+      moves.add(AntiCirceAndernachCapture(origin, target, rebirth, castling));
     } else {
-      bool castling = piece->isCastling();
-      moves.push_back(std::make_unique<AntiCirceCapture>(origin, target,
-                                                         rebirth, castling));
+      bool castling = piece.isCastling();
+      moves.add(AntiCirceCapture(origin, target, rebirth, castling));
     }
   }
   return true;
 }
 bool AntiCirceAndernachMoveFactory::generateCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target) const {
+    const Board& board, int origin, int target) const {
   return AntiCirceMoveFactory::generateCapture(board, origin, target);
 }
 bool AntiCirceAndernachMoveFactory::generateEnPassant(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop, std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::unique_ptr<Piece>& piece = board.at(origin);
-  int rebirth = piece->findRebirthSquare(board, target, false);
+    const Board& board, int origin, int target, int stop,
+    MoveList& moves) const {
+  const Piece& piece = board.getPiece(origin);
+  int rebirth = piece.findRebirthSquare(board, target, false);
   if ((!board.at(rebirth) || rebirth == origin || rebirth == stop) &&
       (calvet_ || !(rebirth == target))) {
-    if (board.at(stop)->isRoyal()) {
+    if (board.getPiece(stop).isRoyal()) {
       return false;
     }
-    if (!piece->isRoyal()) {
-      bool castling = piece->isCastling() &&
-                      piece->findRebirthSquare(board, rebirth, true) == rebirth;
-      moves.push_back(std::make_unique<AntiCirceAndernachEnPassant>(
-          origin, target, stop, rebirth, castling));
+    if (!piece.isRoyal()) {
+      bool castling = piece.isCastling() &&
+                      piece.findRebirthSquare(board, rebirth, true) == rebirth;
+      moves.add(AntiCirceAndernachEnPassant(origin, target, rebirth, castling));
     } else {
-      bool castling = piece->isCastling();
-      moves.push_back(std::make_unique<AntiCirceEnPassant>(origin, target, stop,
-                                                           rebirth, castling));
+      bool castling = piece.isCastling();
+      moves.add(AntiCirceEnPassant(origin, target, rebirth, castling));
     }
   }
   return true;
 }
-bool AntiCirceAndernachMoveFactory::generateEnPassant(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop) const {
-  return AntiCirceMoveFactory::generateEnPassant(board, origin, target, stop);
-}
 bool AntiCirceAndernachMoveFactory::generatePromotionCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::unique_ptr<Piece>& piece = box.at(black).at(order).front();
-  int rebirth = piece->findRebirthSquare(board, target, false);
+    const Board& board, int origin, int target, bool black, int type,
+    MoveList& moves) const {
+  const Piece& piece = Board::toPiece(Board::toCode(type, black));
+  int rebirth = piece.findRebirthSquare(board, target, false);
   if (!board.at(rebirth) || rebirth == origin || calvet_ && rebirth == target) {
-    if (board.at(target)->isRoyal()) {
+    if (board.getPiece(target).isRoyal()) {
       return false;
     }
-    if (!piece->isRoyal()) {
-      bool castling = piece->isCastling() &&
-                      piece->findRebirthSquare(board, rebirth, true) == rebirth;
-      moves.push_back(std::make_unique<AntiCirceAndernachPromotionCapture>(
-          origin, target, black, order, rebirth, castling));
+    if (!piece.isRoyal()) {
+      bool castling = piece.isCastling() &&
+                      piece.findRebirthSquare(board, rebirth, true) == rebirth;
+      moves.add(AntiCirceAndernachPromotionCapture(origin, target, type,
+                                                   rebirth, castling));
     } else {
-      bool castling = piece->isCastling();
-      moves.push_back(std::make_unique<AntiCircePromotionCapture>(
-          origin, target, black, order, rebirth, castling));
+      bool castling = piece.isCastling();
+      moves.add(AntiCircePromotionCapture(origin, target, type, rebirth,
+                                          castling));
     }
   }
   return true;
 }
 bool AntiCirceAndernachMoveFactory::generatePromotionCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order) const {
-  return AntiCirceMoveFactory::generatePromotionCapture(board, box, origin,
-                                                        target, black, order);
+    const Board& board, int origin, int target, bool black, int type) const {
+  return AntiCirceMoveFactory::generatePromotionCapture(board, origin, target,
+                                                        black, type);
 }
 
 void NoCaptureAntiAndernachMoveFactory::write(std::ostream& output) const {
   output << "NoCaptureAntiAndernachMoveFactory[]";
 }
 void NoCaptureAntiAndernachMoveFactory::generateQuietMove(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, std::vector<std::unique_ptr<Move>>& moves) const {
+    const Board& board, int origin, int target, MoveList& moves) const {
   AntiAndernachMoveFactory::generateQuietMove(board, origin, target, moves);
 }
 bool NoCaptureAntiAndernachMoveFactory::generateCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, std::vector<std::unique_ptr<Move>>& moves) const {
+    const Board& board, int origin, int target, MoveList& moves) const {
   return NoCaptureMoveFactory::generateCapture(board, origin, target, moves);
 }
 void NoCaptureAntiAndernachMoveFactory::generateDoubleStep(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop, std::vector<std::unique_ptr<Move>>& moves) const {
+    const Board& board, int origin, int target, int stop,
+    MoveList& moves) const {
   AntiAndernachMoveFactory::generateDoubleStep(board, origin, target, stop,
                                                moves);
 }
 bool NoCaptureAntiAndernachMoveFactory::generateEnPassant(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop, std::vector<std::unique_ptr<Move>>& moves) const {
+    const Board& board, int origin, int target, int stop,
+    MoveList& moves) const {
   return NoCaptureMoveFactory::generateEnPassant(board, origin, target, stop,
                                                  moves);
 }
 void NoCaptureAntiAndernachMoveFactory::generatePromotion(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  AntiAndernachMoveFactory::generatePromotion(board, box, origin, target, black,
-                                              order, moves);
+    const Board& board, int origin, int target, bool black, int type,
+    MoveList& moves) const {
+  AntiAndernachMoveFactory::generatePromotion(board, origin, target, black,
+                                              type, moves);
 }
 bool NoCaptureAntiAndernachMoveFactory::generatePromotionCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  return NoCaptureMoveFactory::generatePromotionCapture(
-      board, box, origin, target, black, order, moves);
+    const Board& board, int origin, int target, bool black, int type,
+    MoveList& moves) const {
+  return NoCaptureMoveFactory::generatePromotionCapture(board, origin, target,
+                                                        black, type, moves);
 }
 
 void CirceAntiAndernachMoveFactory::write(std::ostream& output) const {
   output << "CirceAntiAndernachMoveFactory[]";
 }
 void CirceAntiAndernachMoveFactory::generateQuietMove(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, std::vector<std::unique_ptr<Move>>& moves) const {
+    const Board& board, int origin, int target, MoveList& moves) const {
   AntiAndernachMoveFactory::generateQuietMove(board, origin, target, moves);
 }
 bool CirceAntiAndernachMoveFactory::generateCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, std::vector<std::unique_ptr<Move>>& moves) const {
+    const Board& board, int origin, int target, MoveList& moves) const {
   return CirceMoveFactory::generateCapture(board, origin, target, moves);
 }
 void CirceAntiAndernachMoveFactory::generateDoubleStep(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop, std::vector<std::unique_ptr<Move>>& moves) const {
+    const Board& board, int origin, int target, int stop,
+    MoveList& moves) const {
   AntiAndernachMoveFactory::generateDoubleStep(board, origin, target, stop,
                                                moves);
 }
 bool CirceAntiAndernachMoveFactory::generateEnPassant(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop, std::vector<std::unique_ptr<Move>>& moves) const {
+    const Board& board, int origin, int target, int stop,
+    MoveList& moves) const {
   return CirceMoveFactory::generateEnPassant(board, origin, target, stop,
                                              moves);
 }
 void CirceAntiAndernachMoveFactory::generatePromotion(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  AntiAndernachMoveFactory::generatePromotion(board, box, origin, target, black,
-                                              order, moves);
+    const Board& board, int origin, int target, bool black, int type,
+    MoveList& moves) const {
+  AntiAndernachMoveFactory::generatePromotion(board, origin, target, black,
+                                              type, moves);
 }
 bool CirceAntiAndernachMoveFactory::generatePromotionCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  return CirceMoveFactory::generatePromotionCapture(board, box, origin, target,
-                                                    black, order, moves);
+    const Board& board, int origin, int target, bool black, int type,
+    MoveList& moves) const {
+  return CirceMoveFactory::generatePromotionCapture(board, origin, target,
+                                                    black, type, moves);
 }
 
 AntiCirceAntiAndernachMoveFactory::AntiCirceAntiAndernachMoveFactory(
@@ -602,62 +508,45 @@ void AntiCirceAntiAndernachMoveFactory::write(std::ostream& output) const {
   output << "AntiCirceAntiAndernachMoveFactory[calvet=" << calvet_ << "]";
 }
 void AntiCirceAntiAndernachMoveFactory::generateQuietMove(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, std::vector<std::unique_ptr<Move>>& moves) const {
+    const Board& board, int origin, int target, MoveList& moves) const {
   AntiAndernachMoveFactory::generateQuietMove(board, origin, target, moves);
 }
 bool AntiCirceAntiAndernachMoveFactory::generateCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, std::vector<std::unique_ptr<Move>>& moves) const {
+    const Board& board, int origin, int target, MoveList& moves) const {
   return AntiCirceMoveFactory::generateCapture(board, origin, target, moves);
 }
 bool AntiCirceAntiAndernachMoveFactory::generateCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target) const {
+    const Board& board, int origin, int target) const {
   return AntiCirceMoveFactory::generateCapture(board, origin, target);
 }
 void AntiCirceAntiAndernachMoveFactory::generateDoubleStep(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop, std::vector<std::unique_ptr<Move>>& moves) const {
+    const Board& board, int origin, int target, int stop,
+    MoveList& moves) const {
   AntiAndernachMoveFactory::generateDoubleStep(board, origin, target, stop,
                                                moves);
 }
 bool AntiCirceAntiAndernachMoveFactory::generateEnPassant(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop, std::vector<std::unique_ptr<Move>>& moves) const {
+    const Board& board, int origin, int target, int stop,
+    MoveList& moves) const {
   return AntiCirceMoveFactory::generateEnPassant(board, origin, target, stop,
                                                  moves);
 }
-bool AntiCirceAntiAndernachMoveFactory::generateEnPassant(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop) const {
-  return AntiCirceMoveFactory::generateEnPassant(board, origin, target, stop);
-}
 void AntiCirceAntiAndernachMoveFactory::generatePromotion(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  AntiAndernachMoveFactory::generatePromotion(board, box, origin, target, black,
-                                              order, moves);
+    const Board& board, int origin, int target, bool black, int type,
+    MoveList& moves) const {
+  AntiAndernachMoveFactory::generatePromotion(board, origin, target, black,
+                                              type, moves);
 }
 bool AntiCirceAntiAndernachMoveFactory::generatePromotionCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  return AntiCirceMoveFactory::generatePromotionCapture(
-      board, box, origin, target, black, order, moves);
+    const Board& board, int origin, int target, bool black, int type,
+    MoveList& moves) const {
+  return AntiCirceMoveFactory::generatePromotionCapture(board, origin, target,
+                                                        black, type, moves);
 }
 bool AntiCirceAntiAndernachMoveFactory::generatePromotionCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order) const {
-  return AntiCirceMoveFactory::generatePromotionCapture(board, box, origin,
-                                                        target, black, order);
+    const Board& board, int origin, int target, bool black, int type) const {
+  return AntiCirceMoveFactory::generatePromotionCapture(board, origin, target,
+                                                        black, type);
 }
 
 }  // namespace moderato
@@ -32,38 +32,28 @@ class NoCaptureMoveFactory : virtual public MoveFactory {
   void write(std::ostream& output) const override;
 
  public:
-  bool generateCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateEnPassant(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int stop,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generatePromotionCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
+  using MoveFactory::generateCapture;
+  using MoveFactory::generatePromotionCapture;
+  bool generateCapture(const Board& board, int origin, int target,
+                       MoveList& moves) const;
+  bool generateEnPassant(const Board& board, int origin, int target, int stop,
+                         MoveList& moves) const;
+  bool generatePromotionCapture(const Board& board, int origin, int target,
+                                bool black, int type, MoveList& moves) const;
 };
 
 class CirceMoveFactory : virtual public MoveFactory {
   void write(std::ostream& output) const override;
 
  public:
-  bool generateCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateEnPassant(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int stop,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generatePromotionCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
+  using MoveFactory::generateCapture;
+  using MoveFactory::generatePromotionCapture;
+  bool generateCapture(const Board& board, int origin, int target,
+                       MoveList& moves) const;
+  bool generateEnPassant(const Board& board, int origin, int target, int stop,
+                         MoveList& moves) const;
+  bool generatePromotionCapture(const Board& board, int origin, int target,
+                                bool black, int type, MoveList& moves) const;
 };
 
 class AntiCirceMoveFactory : virtual public MoveFactory {
@@ -74,85 +64,55 @@ class AntiCirceMoveFactory : virtual public MoveFactory {
 
  public:
   AntiCirceMoveFactory(bool calvet);
-  bool generateCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateCapture(const std::array<std::unique_ptr<Piece>, 128>& board,
-                       int origin, int target) const override;
-  bool generateEnPassant(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int stop,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateEnPassant(const std::array<std::unique_ptr<Piece>, 128>& board,
-                         int origin, int target, int stop) const override;
-  bool generatePromotionCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generatePromotionCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order) const override;
+  bool generateCapture(const Board& board, int origin, int target,
+                       MoveList& moves) const;
+  bool generateCapture(const Board& board, int origin, int target) const;
+  bool generateEnPassant(const Board& board, int origin, int target, int stop,
+                         MoveList& moves) const;
+  bool generatePromotionCapture(const Board& board, int origin, int target,
+                                bool black, int type, MoveList& moves) const;
+  bool generatePromotionCapture(const Board& board, int origin, int target,
+                                bool black, int type) const;
 };
 
 class AndernachMoveFactory : virtual public MoveFactory {
   void write(std::ostream& output) const override;
 
  public:
-  bool generateCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateEnPassant(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int stop,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generatePromotionCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
+  using MoveFactory::generateCapture;
+  using MoveFactory::generatePromotionCapture;
+  bool generateCapture(const Board& board, int origin, int target,
+                       MoveList& moves) const;
+  bool generateEnPassant(const Board& board, int origin, int target, int stop,
+                         MoveList& moves) const;
+  bool generatePromotionCapture(const Board& board, int origin, int target,
+                                bool black, int type, MoveList& moves) const;
 };
 
 class AntiAndernachMoveFactory : virtual public MoveFactory {
   void write(std::ostream& output) const override;
 
  public:
-  void generateQuietMove(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, std::vector<std::unique_ptr<Move>>& moves) const override;
-  void generateDoubleStep(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int stop,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  void generatePromotion(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
+  void generateQuietMove(const Board& board, int origin, int target,
+                         MoveList& moves) const;
+  void generateDoubleStep(const Board& board, int origin, int target, int stop,
+                          MoveList& moves) const;
+  void generatePromotion(const Board& board, int origin, int target, bool black,
+                         int type, MoveList& moves) const;
 };
 
 class CirceAndernachMoveFactory : public MoveFactory {
   void write(std::ostream& output) const override;
 
  public:
-  bool generateCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateEnPassant(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int stop,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generatePromotionCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
+  using MoveFactory::generateCapture;
+  using MoveFactory::generatePromotionCapture;
+  bool generateCapture(const Board& board, int origin, int target,
+                       MoveList& moves) const;
+  bool generateEnPassant(const Board& board, int origin, int target, int stop,
+                         MoveList& moves) const;
+  bool generatePromotionCapture(const Board& board, int origin, int target,
+                                bool black, int type, MoveList& moves) const;
 };
 
 class AntiCirceAndernachMoveFactory : public AntiCirceMoveFactory,
@@ -161,28 +121,15 @@ class AntiCirceAndernachMoveFactory : public AntiCirceMoveFactory,
 
  public:
   AntiCirceAndernachMoveFactory(bool calvet);
-  bool generateCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateCapture(const std::array<std::unique_ptr<Piece>, 128>& board,
-                       int origin, int target) const override;
-  bool generateEnPassant(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int stop,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateEnPassant(const std::array<std::unique_ptr<Piece>, 128>& board,
-                         int origin, int target, int stop) const override;
-  bool generatePromotionCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generatePromotionCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order) const override;
+  bool generateCapture(const Board& board, int origin, int target,
+                       MoveList& moves) const;
+  bool generateCapture(const Board& board, int origin, int target) const;
+  bool generateEnPassant(const Board& board, int origin, int target, int stop,
+                         MoveList& moves) const;
+  bool generatePromotionCapture(const Board& board, int origin, int target,
+                                bool black, int type, MoveList& moves) const;
+  bool generatePromotionCapture(const Board& board, int origin, int target,
+                                bool black, int type) const;
 };
 
 class NoCaptureAntiAndernachMoveFactory : public NoCaptureMoveFactory,
@@ -190,32 +137,20 @@ class NoCaptureAntiAndernachMoveFactory : public NoCaptureMoveFactory,
   void write(std::ostream& output) const override;
 
  public:
-  void generateQuietMove(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, std::vector<std::unique_ptr<Move>>& moves) const override;
-  void generateDoubleStep(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int stop,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateEnPassant(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int stop,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  void generatePromotion(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generatePromotionCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
+  using MoveFactory::generateCapture;
+  using MoveFactory::generatePromotionCapture;
+  void generateQuietMove(const Board& board, int origin, int target,
+                         MoveList& moves) const;
+  bool generateCapture(const Board& board, int origin, int target,
+                       MoveList& moves) const;
+  void generateDoubleStep(const Board& board, int origin, int target, int stop,
+                          MoveList& moves) const;
+  bool generateEnPassant(const Board& board, int origin, int target, int stop,
+                         MoveList& moves) const;
+  void generatePromotion(const Board& board, int origin, int target, bool black,
+                         int type, MoveList& moves) const;
+  bool generatePromotionCapture(const Board& board, int origin, int target,
+                                bool black, int type, MoveList& moves) const;
 };
 
 class CirceAntiAndernachMoveFactory : public CirceMoveFactory,
@@ -223,32 +158,20 @@ class CirceAntiAndernachMoveFactory : public CirceMoveFactory,
   void write(std::ostream& output) const override;
 
  public:
-  void generateQuietMove(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, std::vector<std::unique_ptr<Move>>& moves) const override;
-  void generateDoubleStep(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int stop,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateEnPassant(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int stop,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  void generatePromotion(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generatePromotionCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
+  using MoveFactory::generateCapture;
+  using MoveFactory::generatePromotionCapture;
+  void generateQuietMove(const Board& board, int origin, int target,
+                         MoveList& moves) const;
+  bool generateCapture(const Board& board, int origin, int target,
+                       MoveList& moves) const;
+  void generateDoubleStep(const Board& board, int origin, int target, int stop,
+                          MoveList& moves) const;
+  bool generateEnPassant(const Board& board, int origin, int target, int stop,
+                         MoveList& moves) const;
+  void generatePromotion(const Board& board, int origin, int target, bool black,
+                         int type, MoveList& moves) const;
+  bool generatePromotionCapture(const Board& board, int origin, int target,
+                                bool black, int type, MoveList& moves) const;
 };
 
 class AntiCirceAntiAndernachMoveFactory : public AntiCirceMoveFactory,
@@ -257,41 +180,21 @@ class AntiCirceAntiAndernachMoveFactory : public AntiCirceMoveFactory,
 
  public:
   AntiCirceAntiAndernachMoveFactory(bool calvet);
-  void generateQuietMove(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateCapture(const std::array<std::unique_ptr<Piece>, 128>& board,
-                       int origin, int target) const override;
-  void generateDoubleStep(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int stop,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateEnPassant(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int stop,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateEnPassant(const std::array<std::unique_ptr<Piece>, 128>& board,
-                         int origin, int target, int stop) const override;
-  void generatePromotion(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generatePromotionCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generatePromotionCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order) const override;
+  void generateQuietMove(const Board& board, int origin, int target,
+                         MoveList& moves) const;
+  bool generateCapture(const Board& board, int origin, int target,
+                       MoveList& moves) const;
+  bool generateCapture(const Board& board, int origin, int target) const;
+  void generateDoubleStep(const Board& board, int origin, int target, int stop,
+                          MoveList& moves) const;
+  bool generateEnPassant(const Board& board, int origin, int target, int stop,
+                         MoveList& moves) const;
+  void generatePromotion(const Board& board, int origin, int target, bool black,
+                         int type, MoveList& moves) const;
+  bool generatePromotionCapture(const Board& board, int origin, int target,
+                                bool black, int type, MoveList& moves) const;
+  bool generatePromotionCapture(const Board& board, int origin, int target,
+                                bool black, int type) const;
 };
 
 }  // namespace moderato
@@ -1,7 +1,7 @@
 /*
  * MIT License
  *
- * Copyright (c) 2025 Ivan Denkovski
+ * Copyright (c) 2024-2025 Ivan Denkovski
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -26,799 +26,529 @@
 
 namespace moderato {
 
-CirceMove::CirceMove(int rebirth, bool castling)
-    : rebirth_(rebirth), castling_(castling) {}
-
 CirceCapture::CirceCapture(int origin, int target, int rebirth, bool castling)
-    : Capture(origin, target), CirceMove(rebirth, castling) {}
-void CirceCapture::write(std::ostream& output) const {
-  output << "CirceCapture[origin=" << origin_ << ", target=" << target_
-         << ", rebirth=" << rebirth_ << ", castling=" << castling_ << "]";
-}
-void CirceCapture::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(target_)));
-  board.at(target_) = std::move(board.at(origin_));
-  board.at(rebirth_) = std::move(table.top());
-  table.pop();
-}
-void CirceCapture::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(rebirth_)));
-  board.at(origin_) = std::move(board.at(target_));
-  board.at(target_) = std::move(table.top());
-  table.pop();
-}
-void CirceCapture::updateCastlings(std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  castlings.erase(target_);
-  if (castling_) {
-    castlings.insert(rebirth_);
-  } else {
-    castlings.erase(rebirth_);
-  }
-}
-void CirceCapture::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_) << "("
-             << board.at(target_)->getCode(translate) << toCode(board, rebirth_)
-             << ")";
-}
+    : Move(CIRCE_CAPTURE, origin, target, rebirth, 0, castling, false) {}
 
-CirceEnPassant::CirceEnPassant(int origin, int target, int stop, int rebirth,
+CirceEnPassant::CirceEnPassant(int origin, int target, int rebirth,
                                bool castling)
-    : EnPassant(origin, target, stop), CirceMove(rebirth, castling) {}
-void CirceEnPassant::write(std::ostream& output) const {
-  output << "CirceEnPassant[origin=" << origin_ << ", target=" << target_
-         << ", stop=" << stop_ << ", rebirth=" << rebirth_
-         << ", castling=" << castling_ << "]";
-}
-void CirceEnPassant::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(stop_)));
-  board.at(target_) = std::move(board.at(origin_));
-  board.at(rebirth_) = std::move(table.top());
-  table.pop();
-}
-void CirceEnPassant::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(rebirth_)));
-  board.at(origin_) = std::move(board.at(target_));
-  board.at(stop_) = std::move(table.top());
-  table.pop();
-}
-void CirceEnPassant::updateCastlings(std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  castlings.erase(target_);
-  castlings.erase(stop_);
-  if (castling_) {
-    castlings.insert(rebirth_);
-  } else {
-    castlings.erase(rebirth_);
-  }
-}
-void CirceEnPassant::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_) << " e.p." << "("
-             << board.at(stop_)->getCode(translate) << toCode(board, rebirth_)
-             << ")";
-}
+    : Move(CIRCE_EN_PASSANT, origin, target, rebirth, 0, castling, false) {}
 
-CircePromotionCapture::CircePromotionCapture(int origin, int target, bool black,
-                                             int order, int rebirth,
-                                             bool castling)
-    : PromotionCapture(origin, target, black, order),
-      CirceMove(rebirth, castling) {}
-void CircePromotionCapture::write(std::ostream& output) const {
-  output << "CircePromotionCapture[origin=" << origin_ << ", target=" << target_
-         << ", black=" << black_ << ", order=" << order_
-         << ", rebirth=" << rebirth_ << ", castling=" << castling_ << "]";
-}
-void CircePromotionCapture::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(target_)));
-  box.at(black_).at(order_).push_back(std::move(board.at(origin_)));
-  board.at(target_) = std::move(box.at(black_).at(order_).front());
-  box.at(black_).at(order_).pop_front();
-  board.at(rebirth_) = std::move(table.top());
-  table.pop();
-}
-void CircePromotionCapture::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(rebirth_)));
-  box.at(black_).at(order_).push_front(std::move(board.at(target_)));
-  board.at(origin_) = std::move(box.at(black_).at(order_).back());
-  box.at(black_).at(order_).pop_back();
-  board.at(target_) = std::move(table.top());
-  table.pop();
-}
-void CircePromotionCapture::updateCastlings(std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  castlings.erase(target_);
-  if (castling_) {
-    castlings.insert(rebirth_);
-  } else {
-    castlings.erase(rebirth_);
-  }
-}
-void CircePromotionCapture::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_) << "="
-             << box.at(black_).at(order_).front()->getCode(translate) << "("
-             << board.at(target_)->getCode(translate) << toCode(board, rebirth_)
-             << ")";
-}
-
-AntiCirceMove::AntiCirceMove(int rebirth, bool castling)
-    : rebirth_(rebirth), castling_(castling) {}
+CircePromotionCapture::CircePromotionCapture(int origin, int target, int type,
+                                             int rebirth, bool castling)
+    : Move(CIRCE_PROMOTION_CAPTURE, origin, target, rebirth, type, castling,
+           false) {}
 
 AntiCirceCapture::AntiCirceCapture(int origin, int target, int rebirth,
                                    bool castling)
-    : Capture(origin, target), AntiCirceMove(rebirth, castling) {}
-void AntiCirceCapture::write(std::ostream& output) const {
-  output << "AntiCirceCapture[origin=" << origin_ << ", target=" << target_
-         << ", rebirth=" << rebirth_ << ", castling=" << castling_ << "]";
-}
-void AntiCirceCapture::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(target_)));
-  board.at(rebirth_) = std::move(board.at(origin_));
-}
-void AntiCirceCapture::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  board.at(origin_) = std::move(board.at(rebirth_));
-  board.at(target_) = std::move(table.top());
-  table.pop();
-}
-void AntiCirceCapture::updateCastlings(std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  castlings.erase(target_);
-  if (castling_) {
-    castlings.insert(rebirth_);
-  } else {
-    castlings.erase(rebirth_);
-  }
-}
-void AntiCirceCapture::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_) << "("
-             << board.at(origin_)->getCode(translate) << toCode(board, rebirth_)
-             << ")";
-}
+    : Move(ANTI_CIRCE_CAPTURE, origin, target, rebirth, 0, castling, false) {}
 
-AntiCirceEnPassant::AntiCirceEnPassant(int origin, int target, int stop,
-                                       int rebirth, bool castling)
-    : EnPassant(origin, target, stop), AntiCirceMove(rebirth, castling) {}
-void AntiCirceEnPassant::write(std::ostream& output) const {
-  output << "AntiCirceEnPassant[origin=" << origin_ << ", target=" << target_
-         << ", stop=" << stop_ << ", rebirth=" << rebirth_
-         << ", castling=" << castling_ << "]";
-}
-void AntiCirceEnPassant::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(stop_)));
-  board.at(rebirth_) = std::move(board.at(origin_));
-}
-void AntiCirceEnPassant::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  board.at(origin_) = std::move(board.at(rebirth_));
-  board.at(stop_) = std::move(table.top());
-  table.pop();
-}
-void AntiCirceEnPassant::updateCastlings(std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  castlings.erase(target_);
-  castlings.erase(stop_);
-  if (castling_) {
-    castlings.insert(rebirth_);
-  } else {
-    castlings.erase(rebirth_);
-  }
-}
-void AntiCirceEnPassant::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_) << " e.p." << "("
-             << board.at(origin_)->getCode(translate) << toCode(board, rebirth_)
-             << ")";
-}
+AntiCirceEnPassant::AntiCirceEnPassant(int origin, int target, int rebirth,
+                                       bool castling)
+    : Move(ANTI_CIRCE_EN_PASSANT, origin, target, rebirth, 0, castling,
+           false) {}
 
 AntiCircePromotionCapture::AntiCircePromotionCapture(int origin, int target,
-                                                     bool black, int order,
-                                                     int rebirth, bool castling)
-    : PromotionCapture(origin, target, black, order),
-      AntiCirceMove(rebirth, castling) {}
-void AntiCircePromotionCapture::write(std::ostream& output) const {
-  output << "AntiCircePromotionCapture[origin=" << origin_
-         << ", target=" << target_ << ", black=" << black_
-         << ", order=" << order_ << ", rebirth=" << rebirth_
-         << ", castling=" << castling_ << "]";
-}
-void AntiCircePromotionCapture::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(target_)));
-  box.at(black_).at(order_).push_back(std::move(board.at(origin_)));
-  board.at(rebirth_) = std::move(box.at(black_).at(order_).front());
-  box.at(black_).at(order_).pop_front();
-}
-void AntiCircePromotionCapture::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  box.at(black_).at(order_).push_front(std::move(board.at(rebirth_)));
-  board.at(origin_) = std::move(box.at(black_).at(order_).back());
-  box.at(black_).at(order_).pop_back();
-  board.at(target_) = std::move(table.top());
-  table.pop();
-}
-void AntiCircePromotionCapture::updateCastlings(
-    std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  castlings.erase(target_);
-  if (castling_) {
-    castlings.insert(rebirth_);
-  } else {
-    castlings.erase(rebirth_);
-  }
-}
-void AntiCircePromotionCapture::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_) << "="
-             << box.at(black_).at(order_).front()->getCode(translate) << "("
-             << box.at(black_).at(order_).front()->getCode(translate)
-             << toCode(board, rebirth_) << ")";
-}
-
-AndernachMove::AndernachMove(bool castling) : castling_(castling) {}
+                                                     int type, int rebirth,
+                                                     bool castling)
+    : Move(ANTI_CIRCE_PROMOTION_CAPTURE, origin, target, rebirth, type,
+           castling, false) {}
 
 AndernachCapture::AndernachCapture(int origin, int target, bool castling)
-    : Capture(origin, target), AndernachMove(castling) {}
-void AndernachCapture::write(std::ostream& output) const {
-  output << "AndernachCapture[origin=" << origin_ << ", target=" << target_
-         << ", castling=" << castling_ << "]";
-}
-void AndernachCapture::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(target_)));
-  board.at(target_) = std::move(board.at(origin_));
-  board.at(target_)->isBlack() = !board.at(target_)->isBlack();
-}
-void AndernachCapture::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  board.at(target_)->isBlack() = !board.at(target_)->isBlack();
-  board.at(origin_) = std::move(board.at(target_));
-  board.at(target_) = std::move(table.top());
-  table.pop();
-}
-void AndernachCapture::updateCastlings(std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  if (castling_) {
-    castlings.insert(target_);
-  } else {
-    castlings.erase(target_);
-  }
-}
-void AndernachCapture::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_) << "("
-             << toCode(!board.at(origin_)->isBlack(), translate) << ")";
-}
+    : Move(ANDERNACH_CAPTURE, origin, target, 0, 0, castling, false) {}
 
-AndernachEnPassant::AndernachEnPassant(int origin, int target, int stop,
-                                       bool castling)
-    : EnPassant(origin, target, stop), AndernachMove(castling) {}
-void AndernachEnPassant::write(std::ostream& output) const {
-  output << "AndernachEnPassant[origin=" << origin_ << ", target=" << target_
-         << ", stop=" << stop_ << ", castling=" << castling_ << "]";
-}
-void AndernachEnPassant::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(stop_)));
-  board.at(target_) = std::move(board.at(origin_));
-  board.at(target_)->isBlack() = !board.at(target_)->isBlack();
-}
-void AndernachEnPassant::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  board.at(target_)->isBlack() = !board.at(target_)->isBlack();
-  board.at(origin_) = std::move(board.at(target_));
-  board.at(stop_) = std::move(table.top());
-  table.pop();
-}
-void AndernachEnPassant::updateCastlings(std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  if (castling_) {
-    castlings.insert(target_);
-  } else {
-    castlings.erase(target_);
-  }
-  castlings.erase(stop_);
-}
-void AndernachEnPassant::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_) << " e.p." << "("
-             << toCode(!board.at(origin_)->isBlack(), translate) << ")";
-}
+AndernachEnPassant::AndernachEnPassant(int origin, int target, bool castling)
+    : Move(ANDERNACH_EN_PASSANT, origin, target, 0, 0, castling, false) {}
 
 AndernachPromotionCapture::AndernachPromotionCapture(int origin, int target,
-                                                     bool black, int order,
-                                                     bool castling)
-    : PromotionCapture(origin, target, black, order), AndernachMove(castling) {}
-void AndernachPromotionCapture::write(std::ostream& output) const {
-  output << "AndernachPromotionCapture[origin=" << origin_
-         << ", target=" << target_ << ", black=" << black_
-         << ", order=" << order_ << ", castling=" << castling_ << "]";
-}
-void AndernachPromotionCapture::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(target_)));
-  box.at(black_).at(order_).push_back(std::move(board.at(origin_)));
-  board.at(target_) = std::move(box.at(black_).at(order_).front());
-  box.at(black_).at(order_).pop_front();
-  board.at(target_)->isBlack() = !board.at(target_)->isBlack();
-}
-void AndernachPromotionCapture::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  board.at(target_)->isBlack() = !board.at(target_)->isBlack();
-  box.at(black_).at(order_).push_front(std::move(board.at(target_)));
-  board.at(origin_) = std::move(box.at(black_).at(order_).back());
-  box.at(black_).at(order_).pop_back();
-  board.at(target_) = std::move(table.top());
-  table.pop();
-}
-void AndernachPromotionCapture::updateCastlings(
-    std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  if (castling_) {
-    castlings.insert(target_);
-  } else {
-    castlings.erase(target_);
-  }
-}
-void AndernachPromotionCapture::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_) << "="
-             << box.at(black_).at(order_).front()->getCode(translate) << "("
-             << toCode(!board.at(origin_)->isBlack(), translate) << ")";
-}
-
-AntiAndernachMove::AntiAndernachMove(bool castling) : castling_(castling) {}
+                                                     int type, bool castling)
+    : Move(ANDERNACH_PROMOTION_CAPTURE, origin, target, 0, type, castling,
+           false) {}
 
 AntiAndernachQuietMove::AntiAndernachQuietMove(int origin, int target,
                                                bool castling)
-    : QuietMove(origin, target), AntiAndernachMove(castling) {}
-void AntiAndernachQuietMove::write(std::ostream& output) const {
-  output << "AntiAndernachQuietMove[origin=" << origin_
-         << ", target=" << target_ << ", castling=" << castling_ << "]";
-}
-void AntiAndernachQuietMove::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board) const {
-  board.at(target_) = std::move(board.at(origin_));
-  board.at(target_)->isBlack() = !board.at(target_)->isBlack();
-}
-void AntiAndernachQuietMove::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board) const {
-  board.at(target_)->isBlack() = !board.at(target_)->isBlack();
-  board.at(origin_) = std::move(board.at(target_));
-}
-void AntiAndernachQuietMove::updateCastlings(std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  if (castling_) {
-    castlings.insert(target_);
-  } else {
-    castlings.erase(target_);
-  }
-}
-void AntiAndernachQuietMove::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "-" << toCode(board, target_) << "("
-             << toCode(!board.at(origin_)->isBlack(), translate) << ")";
-}
+    : Move(ANTI_ANDERNACH_QUIET_MOVE, origin, target, 0, 0, castling, false) {}
 
 AntiAndernachPromotion::AntiAndernachPromotion(int origin, int target,
-                                               bool black, int order,
-                                               bool castling)
-    : Promotion(origin, target, black, order), AntiAndernachMove(castling) {}
-void AntiAndernachPromotion::write(std::ostream& output) const {
-  output << "AntiAndernachPromotion[origin=" << origin_
-         << ", target=" << target_ << ", black=" << black_
-         << ", order=" << order_ << ", castling=" << castling_ << "]";
-}
-void AntiAndernachPromotion::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box)
-    const {
-  box.at(black_).at(order_).push_back(std::move(board.at(origin_)));
-  board.at(target_) = std::move(box.at(black_).at(order_).front());
-  box.at(black_).at(order_).pop_front();
-  board.at(target_)->isBlack() = !board.at(target_)->isBlack();
-}
-void AntiAndernachPromotion::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box)
-    const {
-  board.at(target_)->isBlack() = !board.at(target_)->isBlack();
-  box.at(black_).at(order_).push_front(std::move(board.at(target_)));
-  board.at(origin_) = std::move(box.at(black_).at(order_).back());
-  box.at(black_).at(order_).pop_back();
-}
-void AntiAndernachPromotion::updateCastlings(std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  if (castling_) {
-    castlings.insert(target_);
-  } else {
-    castlings.erase(target_);
-  }
-}
-void AntiAndernachPromotion::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "-" << toCode(board, target_) << "="
-             << box.at(black_).at(order_).front()->getCode(translate) << "("
-             << toCode(!board.at(origin_)->isBlack(), translate) << ")";
+                                               int type, bool castling)
+    : Move(ANTI_ANDERNACH_PROMOTION, origin, target, 0, type, castling, false) {
 }
 
-CirceAndernachMove::CirceAndernachMove(int rebirth, bool castling,
-                                       bool castling2)
-    : rebirth_(rebirth), castling_(castling), castling2_(castling2) {}
-
 CirceAndernachCapture::CirceAndernachCapture(int origin, int target,
                                              int rebirth, bool castling,
                                              bool castling2)
-    : Capture(origin, target),
-      CirceAndernachMove(rebirth, castling, castling2) {}
-void CirceAndernachCapture::write(std::ostream& output) const {
-  output << "CirceAndernachCapture[origin=" << origin_ << ", target=" << target_
-         << ", rebirth=" << rebirth_ << ", castling=" << castling_
-         << ", castling2=" << castling2_ << "]";
-}
-void CirceAndernachCapture::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(target_)));
-  board.at(target_) = std::move(board.at(origin_));
-  board.at(rebirth_) = std::move(table.top());
-  table.pop();
-  board.at(target_)->isBlack() = !board.at(target_)->isBlack();
-}
-void CirceAndernachCapture::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  board.at(target_)->isBlack() = !board.at(target_)->isBlack();
-  table.push(std::move(board.at(rebirth_)));
-  board.at(origin_) = std::move(board.at(target_));
-  board.at(target_) = std::move(table.top());
-  table.pop();
-}
-void CirceAndernachCapture::updateCastlings(std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  if (castling2_) {
-    castlings.insert(target_);
-  } else {
-    castlings.erase(target_);
-  }
-  if (castling_) {
-    castlings.insert(rebirth_);
-  } else {
-    castlings.erase(rebirth_);
-  }
-}
-void CirceAndernachCapture::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_) << "("
-             << toCode(!board.at(origin_)->isBlack(), translate) << ";"
-             << board.at(target_)->getCode(translate) << toCode(board, rebirth_)
-             << ")";
-}
+    : Move(CIRCE_ANDERNACH_CAPTURE, origin, target, rebirth, 0, castling,
+           castling2) {}
 
 CirceAndernachEnPassant::CirceAndernachEnPassant(int origin, int target,
-                                                 int stop, int rebirth,
-                                                 bool castling, bool castling2)
-    : EnPassant(origin, target, stop),
-      CirceAndernachMove(rebirth, castling, castling2) {}
-void CirceAndernachEnPassant::write(std::ostream& output) const {
-  output << "CirceAndernachEnPassant[origin=" << origin_
-         << ", target=" << target_ << ", stop=" << stop_
-         << ", rebirth=" << rebirth_ << ", castling=" << castling_
-         << ", castling2=" << castling2_ << "]";
-}
-void CirceAndernachEnPassant::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(stop_)));
-  board.at(target_) = std::move(board.at(origin_));
-  board.at(rebirth_) = std::move(table.top());
-  table.pop();
-  board.at(target_)->isBlack() = !board.at(target_)->isBlack();
-}
-void CirceAndernachEnPassant::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  board.at(target_)->isBlack() = !board.at(target_)->isBlack();
-  table.push(std::move(board.at(rebirth_)));
-  board.at(origin_) = std::move(board.at(target_));
-  board.at(stop_) = std::move(table.top());
-  table.pop();
-}
-void CirceAndernachEnPassant::updateCastlings(std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  if (castling2_) {
-    castlings.insert(target_);
-  } else {
-    castlings.erase(target_);
-  }
-  castlings.erase(stop_);
-  if (castling_) {
-    castlings.insert(rebirth_);
-  } else {
-    castlings.erase(rebirth_);
-  }
-}
-void CirceAndernachEnPassant::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_) << " e.p." << "("
-             << toCode(!board.at(origin_)->isBlack(), translate) << ";"
-             << board.at(target_)->getCode(translate) << toCode(board, rebirth_)
-             << ")";
-}
+                                                 int rebirth, bool castling,
+                                                 bool castling2)
+    : Move(CIRCE_ANDERNACH_EN_PASSANT, origin, target, rebirth, 0, castling,
+           castling2) {}
 
 CirceAndernachPromotionCapture::CirceAndernachPromotionCapture(
-    int origin, int target, bool black, int order, int rebirth, bool castling,
+    int origin, int target, int type, int rebirth, bool castling,
     bool castling2)
-    : PromotionCapture(origin, target, black, order),
-      CirceAndernachMove(rebirth, castling, castling2) {}
-void CirceAndernachPromotionCapture::write(std::ostream& output) const {
-  output << "CirceAndernachPromotionCapture[origin=" << origin_
-         << ", target=" << target_ << ", black=" << black_
-         << ", order=" << order_ << ", rebirth=" << rebirth_
-         << ", castling=" << castling_ << ", castling2=" << castling2_ << "]";
-}
-void CirceAndernachPromotionCapture::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(target_)));
-  box.at(black_).at(order_).push_back(std::move(board.at(origin_)));
-  board.at(target_) = std::move(box.at(black_).at(order_).front());
-  box.at(black_).at(order_).pop_front();
-  board.at(rebirth_) = std::move(table.top());
-  table.pop();
-  board.at(target_)->isBlack() = !board.at(target_)->isBlack();
-}
-void CirceAndernachPromotionCapture::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  board.at(target_)->isBlack() = !board.at(target_)->isBlack();
-  table.push(std::move(board.at(rebirth_)));
-  box.at(black_).at(order_).push_front(std::move(board.at(target_)));
-  board.at(origin_) = std::move(box.at(black_).at(order_).back());
-  box.at(black_).at(order_).pop_back();
-  board.at(target_) = std::move(table.top());
-  table.pop();
-}
-void CirceAndernachPromotionCapture::updateCastlings(
-    std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  if (castling2_) {
-    castlings.insert(target_);
-  } else {
-    castlings.erase(target_);
-  }
-  if (castling_) {
-    castlings.insert(rebirth_);
-  } else {
-    castlings.erase(rebirth_);
-  }
-}
-void CirceAndernachPromotionCapture::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_) << "="
-             << box.at(black_).at(order_).front()->getCode(translate) << "("
-             << toCode(!board.at(origin_)->isBlack(), translate) << ";"
-             << board.at(target_)->getCode(translate) << toCode(board, rebirth_)
-             << ")";
-}
-
-AntiCirceAndernachMove::AntiCirceAndernachMove(int rebirth, bool castling)
-    : rebirth_(rebirth), castling_(castling) {}
+    : Move(CIRCE_ANDERNACH_PROMOTION_CAPTURE, origin, target, rebirth, type,
+           castling, castling2) {}
 
 AntiCirceAndernachCapture::AntiCirceAndernachCapture(int origin, int target,
                                                      int rebirth, bool castling)
-    : Capture(origin, target), AntiCirceAndernachMove(rebirth, castling) {}
-void AntiCirceAndernachCapture::write(std::ostream& output) const {
-  output << "AntiCirceAndernachCapture[origin=" << origin_
-         << ", target=" << target_ << ", rebirth=" << rebirth_
-         << ", castling=" << castling_ << "]";
-}
-void AntiCirceAndernachCapture::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(target_)));
-  board.at(rebirth_) = std::move(board.at(origin_));
-  board.at(rebirth_)->isBlack() = !board.at(rebirth_)->isBlack();
-}
-void AntiCirceAndernachCapture::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  board.at(rebirth_)->isBlack() = !board.at(rebirth_)->isBlack();
-  board.at(origin_) = std::move(board.at(rebirth_));
-  board.at(target_) = std::move(table.top());
-  table.pop();
-}
-void AntiCirceAndernachCapture::updateCastlings(
-    std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  castlings.erase(target_);
-  if (castling_) {
-    castlings.insert(rebirth_);
-  } else {
-    castlings.erase(rebirth_);
-  }
-}
-void AntiCirceAndernachCapture::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_) << "("
-             << board.at(origin_)->getCode(translate) << toCode(board, rebirth_)
-             << toCode(!board.at(origin_)->isBlack(), translate) << ")";
-}
+    : Move(ANTI_CIRCE_ANDERNACH_CAPTURE, origin, target, rebirth, 0, castling,
+           false) {}
 
 AntiCirceAndernachEnPassant::AntiCirceAndernachEnPassant(int origin, int target,
-                                                         int stop, int rebirth,
+                                                         int rebirth,
                                                          bool castling)
-    : EnPassant(origin, target, stop),
-      AntiCirceAndernachMove(rebirth, castling) {}
-void AntiCirceAndernachEnPassant::write(std::ostream& output) const {
-  output << "AntiCirceAndernachEnPassant[origin=" << origin_
-         << ", target=" << target_ << ", stop=" << stop_
-         << ", rebirth=" << rebirth_ << ", castling=" << castling_ << "]";
-}
-void AntiCirceAndernachEnPassant::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(stop_)));
-  board.at(rebirth_) = std::move(board.at(origin_));
-  board.at(rebirth_)->isBlack() = !board.at(rebirth_)->isBlack();
-}
-void AntiCirceAndernachEnPassant::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  board.at(rebirth_)->isBlack() = !board.at(rebirth_)->isBlack();
-  board.at(origin_) = std::move(board.at(rebirth_));
-  board.at(stop_) = std::move(table.top());
-  table.pop();
-}
-void AntiCirceAndernachEnPassant::updateCastlings(
-    std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  castlings.erase(target_);
-  castlings.erase(stop_);
-  if (castling_) {
-    castlings.insert(rebirth_);
-  } else {
-    castlings.erase(rebirth_);
-  }
-}
-void AntiCirceAndernachEnPassant::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_) << " e.p." << "("
-             << board.at(origin_)->getCode(translate) << toCode(board, rebirth_)
-             << toCode(!board.at(origin_)->isBlack(), translate) << ")";
-}
+    : Move(ANTI_CIRCE_ANDERNACH_EN_PASSANT, origin, target, rebirth, 0,
+           castling, false) {}
 
 AntiCirceAndernachPromotionCapture::AntiCirceAndernachPromotionCapture(
-    int origin, int target, bool black, int order, int rebirth, bool castling)
-    : PromotionCapture(origin, target, black, order),
-      AntiCirceAndernachMove(rebirth, castling) {}
-void AntiCirceAndernachPromotionCapture::write(std::ostream& output) const {
-  output << "AntiCirceAndernachPromotionCapture[origin=" << origin_
-         << ", target=" << target_ << ", black=" << black_
-         << ", order=" << order_ << ", rebirth=" << rebirth_
-         << ", castling=" << castling_ << "]";
+    int origin, int target, int type, int rebirth, bool castling)
+    : Move(ANTI_CIRCE_ANDERNACH_PROMOTION_CAPTURE, origin, target, rebirth,
+           type, castling, false) {}
+
+void Move::writeFairy(std::ostream& output) const {
+  switch (getKind()) {
+    case CIRCE_CAPTURE:
+      output << "CirceCapture[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", rebirth=" << getSquare2()
+             << ", castling=" << isCastling() << "]";
+      break;
+    case CIRCE_EN_PASSANT:
+      output << "CirceEnPassant[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", stop=" << getStop()
+             << ", rebirth=" << getSquare2() << ", castling=" << isCastling()
+             << "]";
+      break;
+    case CIRCE_PROMOTION_CAPTURE:
+      output << "CircePromotionCapture[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", black=" << isBlack()
+             << ", type=" << getType() << ", rebirth=" << getSquare2()
+             << ", castling=" << isCastling() << "]";
+      break;
+    case ANTI_CIRCE_CAPTURE:
+      output << "AntiCirceCapture[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", rebirth=" << getSquare2()
+             << ", castling=" << isCastling() << "]";
+      break;
+    case ANTI_CIRCE_EN_PASSANT:
+      output << "AntiCirceEnPassant[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", stop=" << getStop()
+             << ", rebirth=" << getSquare2() << ", castling=" << isCastling()
+             << "]";
+      break;
+    case ANTI_CIRCE_PROMOTION_CAPTURE:
+      output << "AntiCircePromotionCapture[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", black=" << isBlack()
+             << ", type=" << getType() << ", rebirth=" << getSquare2()
+             << ", castling=" << isCastling() << "]";
+      break;
+    case ANDERNACH_CAPTURE:
+      output << "AndernachCapture[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", castling=" << isCastling()
+             << "]";
+      break;
+    case ANDERNACH_EN_PASSANT:
+      output << "AndernachEnPassant[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", stop=" << getStop()
+             << ", castling=" << isCastling() << "]";
+      break;
+    case ANDERNACH_PROMOTION_CAPTURE:
+      output << "AndernachPromotionCapture[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", black=" << isBlack()
+             << ", type=" << getType() << ", castling=" << isCastling() << "]";
+      break;
+    case ANTI_ANDERNACH_QUIET_MOVE:
+      output << "AntiAndernachQuietMove[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", castling=" << isCastling()
+             << "]";
+      break;
+    case ANTI_ANDERNACH_PROMOTION:
+      output << "AntiAndernachPromotion[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", black=" << isBlack()
+             << ", type=" << getType() << ", castling=" << isCastling() << "]";
+      break;
+    case CIRCE_ANDERNACH_CAPTURE:
+      output << "CirceAndernachCapture[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", rebirth=" << getSquare2()
+             << ", castling=" << isCastling()
+             << ", castling2=" << isCastling2() << "]";
+      break;
+    case CIRCE_ANDERNACH_EN_PASSANT:
+      output << "CirceAndernachEnPassant[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", stop=" << getStop()
+             << ", rebirth=" << getSquare2() << ", castling=" << isCastling()
+             << ", castling2=" << isCastling2() << "]";
+      break;
+    case CIRCE_ANDERNACH_PROMOTION_CAPTURE:
+      output << "CirceAndernachPromotionCapture[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", black=" << isBlack()
+             << ", type=" << getType() << ", rebirth=" << getSquare2()
+             << ", castling=" << isCastling()
+             << ", castling2=" << isCastling2() << "]";
+      break;
+    case ANTI_CIRCE_ANDERNACH_CAPTURE:
+      output << "AntiCirceAndernachCapture[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", rebirth=" << getSquare2()
+             << ", castling=" << isCastling() << "]";
+      break;
+    case ANTI_CIRCE_ANDERNACH_EN_PASSANT:
+      output << "AntiCirceAndernachEnPassant[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", stop=" << getStop()
+             << ", rebirth=" << getSquare2() << ", castling=" << isCastling()
+             << "]";
+      break;
+    case ANTI_CIRCE_ANDERNACH_PROMOTION_CAPTURE:
+      output << "AntiCirceAndernachPromotionCapture[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", black=" << isBlack()
+             << ", type=" << getType() << ", rebirth=" << getSquare2()
+             << ", castling=" << isCastling() << "]";
+      break;
+  }
 }
-void AntiCirceAndernachPromotionCapture::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(target_)));
-  box.at(black_).at(order_).push_back(std::move(board.at(origin_)));
-  board.at(rebirth_) = std::move(box.at(black_).at(order_).front());
-  box.at(black_).at(order_).pop_front();
-  board.at(rebirth_)->isBlack() = !board.at(rebirth_)->isBlack();
+void Move::updateFairyPieces(Board& board, std::array<int, 20>& box,
+                             unsigned char& table) const {
+  switch (getKind()) {
+    case CIRCE_CAPTURE:
+      table = board.remove(getTarget());
+      board.move(getOrigin(), getTarget());
+      board.place(getSquare2(), table);
+      break;
+    case CIRCE_EN_PASSANT:
+      table = board.remove(getStop());
+      board.move(getOrigin(), getTarget());
+      board.place(getSquare2(), table);
+      break;
+    case CIRCE_PROMOTION_CAPTURE:
+      table = board.remove(getTarget());
+      board.remove(getOrigin());
+      board.place(getTarget(), Board::toCode(getType(), isBlack()));
+      box[Board::toCode(getType(), isBlack())]--;
+      board.place(getSquare2(), table);
+      break;
+    case ANTI_CIRCE_CAPTURE:
+      table = board.remove(getTarget());
+      board.move(getOrigin(), getSquare2());
+      break;
+    case ANTI_CIRCE_EN_PASSANT:
+      table = board.remove(getStop());
+      board.move(getOrigin(), getSquare2());
+      break;
+    case ANTI_CIRCE_PROMOTION_CAPTURE:
+      table = board.remove(getTarget());
+      board.remove(getOrigin());
+      board.place(getSquare2(), Board::toCode(getType(), isBlack()));
+      box[Board::toCode(getType(), isBlack())]--;
+      break;
+    case ANDERNACH_CAPTURE:
+      table = board.remove(getTarget());
+      board.move(getOrigin(), getTarget());
+      board.changeColour(getTarget());
+      break;
+    case ANDERNACH_EN_PASSANT:
+      table = board.remove(getStop());
+      board.move(getOrigin(), getTarget());
+      board.changeColour(getTarget());
+      break;
+    case ANDERNACH_PROMOTION_CAPTURE:
+      table = board.remove(getTarget());
+      board.remove(getOrigin());
+      board.place(getTarget(), Board::toCode(getType(), isBlack()));
+      box[Board::toCode(getType(), isBlack())]--;
+      board.changeColour(getTarget());
+      break;
+    case ANTI_ANDERNACH_QUIET_MOVE:
+      board.move(getOrigin(), getTarget());
+      board.changeColour(getTarget());
+      break;
+    case ANTI_ANDERNACH_PROMOTION:
+      board.remove(getOrigin());
+      board.place(getTarget(), Board::toCode(getType(), isBlack()));
+      box[Board::toCode(getType(), isBlack())]--;
+      board.changeColour(getTarget());
+      break;
+    case CIRCE_ANDERNACH_CAPTURE:
+      table = board.remove(getTarget());
+      board.move(getOrigin(), getTarget());
+      board.place(getSquare2(), table);
+      board.changeColour(getTarget());
+      break;
+    case CIRCE_ANDERNACH_EN_PASSANT:
+      table = board.remove(getStop());
+      board.move(getOrigin(), getTarget());
+      board.place(getSquare2(), table);
+      board.changeColour(getTarget());
+      break;
+    case CIRCE_ANDERNACH_PROMOTION_CAPTURE:
+      table = board.remove(getTarget());
+      board.remove(getOrigin());
+      board.place(getTarget(), Board::toCode(getType(), isBlack()));
+      box[Board::toCode(getType(), isBlack())]--;
+      board.place(getSquare2(), table);
+      board.changeColour(getTarget());
+      break;
+    case ANTI_CIRCE_ANDERNACH_CAPTURE:
+      table = board.remove(getTarget());
+      board.move(getOrigin(), getSquare2());
+      board.changeColour(getSquare2());
+      break;
+    case ANTI_CIRCE_ANDERNACH_EN_PASSANT:
+      table = board.remove(getStop());
+      board.move(getOrigin(), getSquare2());
+      board.changeColour(getSquare2());
+      break;
+    case ANTI_CIRCE_ANDERNACH_PROMOTION_CAPTURE:
+      table = board.remove(getTarget());
+      board.remove(getOrigin());
+      board.place(getSquare2(), Board::toCode(getType(), isBlack()));
+      box[Board::toCode(getType(), isBlack())]--;
+      board.changeColour(getSquare2());
+      break;
+  }
 }
-void AntiCirceAndernachPromotionCapture::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  board.at(rebirth_)->isBlack() = !board.at(rebirth_)->isBlack();
-  box.at(black_).at(order_).push_front(std::move(board.at(rebirth_)));
-  board.at(origin_) = std::move(box.at(black_).at(order_).back());
-  box.at(black_).at(order_).pop_back();
-  board.at(target_) = std::move(table.top());
-  table.pop();
+void Move::revertFairyPieces(Board& board, std::array<int, 20>& box,
+                             unsigned char& table) const {
+  switch (getKind()) {
+    case CIRCE_CAPTURE:
+      table = board.remove(getSquare2());
+      board.move(getTarget(), getOrigin());
+      board.place(getTarget(), table);
+      break;
+    case CIRCE_EN_PASSANT:
+      table = board.remove(getSquare2());
+      board.move(getTarget(), getOrigin());
+      board.place(getStop(), table);
+      break;
+    case CIRCE_PROMOTION_CAPTURE:
+      table = board.remove(getSquare2());
+      box[Board::toCode(getType(), isBlack())]++;
+      board.remove(getTarget());
+      board.place(getOrigin(), Board::toCode(Board::PAWN, isBlack()));
+      board.place(getTarget(), table);
+      break;
+    case ANTI_CIRCE_CAPTURE:
+      board.move(getSquare2(), getOrigin());
+      board.place(getTarget(), table);
+      break;
+    case ANTI_CIRCE_EN_PASSANT:
+      board.move(getSquare2(), getOrigin());
+      board.place(getStop(), table);
+      break;
+    case ANTI_CIRCE_PROMOTION_CAPTURE:
+      box[Board::toCode(getType(), isBlack())]++;
+      board.remove(getSquare2());
+      board.place(getOrigin(), Board::toCode(Board::PAWN, isBlack()));
+      board.place(getTarget(), table);
+      break;
+    case ANDERNACH_CAPTURE:
+      board.changeColour(getTarget());
+      board.move(getTarget(), getOrigin());
+      board.place(getTarget(), table);
+      break;
+    case ANDERNACH_EN_PASSANT:
+      board.changeColour(getTarget());
+      board.move(getTarget(), getOrigin());
+      board.place(getStop(), table);
+      break;
+    case ANDERNACH_PROMOTION_CAPTURE:
+      board.changeColour(getTarget());
+      box[Board::toCode(getType(), isBlack())]++;
+      board.remove(getTarget());
+      board.place(getOrigin(), Board::toCode(Board::PAWN, isBlack()));
+      board.place(getTarget(), table);
+      break;
+    case ANTI_ANDERNACH_QUIET_MOVE:
+      board.changeColour(getTarget());
+      board.move(getTarget(), getOrigin());
+      break;
+    case ANTI_ANDERNACH_PROMOTION:
+      board.changeColour(getTarget());
+      box[Board::toCode(getType(), isBlack())]++;
+      board.remove(getTarget());
+      board.place(getOrigin(), Board::toCode(Board::PAWN, isBlack()));
+      break;
+    case CIRCE_ANDERNACH_CAPTURE:
+      board.changeColour(getTarget());
+      table = board.remove(getSquare2());
+      board.move(getTarget(), getOrigin());
+      board.place(getTarget(), table);
+      break;
+    case CIRCE_ANDERNACH_EN_PASSANT:
+      board.changeColour(getTarget());
+      table = board.remove(getSquare2());
+      board.move(getTarget(), getOrigin());
+      board.place(getStop(), table);
+      break;
+    case CIRCE_ANDERNACH_PROMOTION_CAPTURE:
+      board.changeColour(getTarget());
+      table = board.remove(getSquare2());
+      box[Board::toCode(getType(), isBlack())]++;
+      board.remove(getTarget());
+      board.place(getOrigin(), Board::toCode(Board::PAWN, isBlack()));
+      board.place(getTarget(), table);
+      break;
+    case ANTI_CIRCE_ANDERNACH_CAPTURE:
+      board.changeColour(getSquare2());
+      board.move(getSquare2(), getOrigin());
+      board.place(getTarget(), table);
+      break;
+    case ANTI_CIRCE_ANDERNACH_EN_PASSANT:
+      board.changeColour(getSquare2());
+      board.move(getSquare2(), getOrigin());
+      board.place(getStop(), table);
+      break;
+    case ANTI_CIRCE_ANDERNACH_PROMOTION_CAPTURE:
+      board.changeColour(getSquare2());
+      box[Board::toCode(getType(), isBlack())]++;
+      board.remove(getSquare2());
+      board.place(getOrigin(), Board::toCode(Board::PAWN, isBlack()));
+      board.place(getTarget(), table);
+      break;
+  }
 }
-void AntiCirceAndernachPromotionCapture::updateCastlings(
-    std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  castlings.erase(target_);
-  if (castling_) {
-    castlings.insert(rebirth_);
+void Move::updateFairyCastlings(int& castlings) const {
+  switch (getKind()) {
+    case CIRCE_CAPTURE:
+    case CIRCE_PROMOTION_CAPTURE:
+    case ANTI_CIRCE_CAPTURE:
+    case ANTI_CIRCE_PROMOTION_CAPTURE:
+    case ANTI_CIRCE_ANDERNACH_CAPTURE:
+    case ANTI_CIRCE_ANDERNACH_PROMOTION_CAPTURE:
+      castlings &= ~Board::toCastling(getOrigin());
+      castlings &= ~Board::toCastling(getTarget());
+      break;
+    case CIRCE_EN_PASSANT:
+    case ANTI_CIRCE_EN_PASSANT:
+    case ANTI_CIRCE_ANDERNACH_EN_PASSANT:
+      castlings &= ~Board::toCastling(getOrigin());
+      castlings &= ~Board::toCastling(getTarget());
+      castlings &= ~Board::toCastling(getStop());
+      break;
+    case ANDERNACH_CAPTURE:
+    case ANDERNACH_PROMOTION_CAPTURE:
+    case ANTI_ANDERNACH_QUIET_MOVE:
+    case ANTI_ANDERNACH_PROMOTION:
+      castlings &= ~Board::toCastling(getOrigin());
+      if (isCastling()) {
+        castlings |= Board::toCastling(getTarget());
+      } else {
+        castlings &= ~Board::toCastling(getTarget());
+      }
+      return;
+    case ANDERNACH_EN_PASSANT:
+      castlings &= ~Board::toCastling(getOrigin());
+      if (isCastling()) {
+        castlings |= Board::toCastling(getTarget());
+      } else {
+        castlings &= ~Board::toCastling(getTarget());
+      }
+      castlings &= ~Board::toCastling(getStop());
+      return;
+    case CIRCE_ANDERNACH_CAPTURE:
+    case CIRCE_ANDERNACH_PROMOTION_CAPTURE:
+      castlings &= ~Board::toCastling(getOrigin());
+      if (isCastling2()) {
+        castlings |= Board::toCastling(getTarget());
+      } else {
+        castlings &= ~Board::toCastling(getTarget());
+      }
+      break;
+    case CIRCE_ANDERNACH_EN_PASSANT:
+      castlings &= ~Board::toCastling(getOrigin());
+      if (isCastling2()) {
+        castlings |= Board::toCastling(getTarget());
+      } else {
+        castlings &= ~Board::toCastling(getTarget());
+      }
+      castlings &= ~Board::toCastling(getStop());
+      break;
+  }
+  if (isCastling()) {
+    castlings |= Board::toCastling(getSquare2());
   } else {
-    castlings.erase(rebirth_);
+    castlings &= ~Board::toCastling(getSquare2());
   }
 }
-void AntiCirceAndernachPromotionCapture::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_) << "="
-             << box.at(black_).at(order_).front()->getCode(translate) << "("
-             << box.at(black_).at(order_).front()->getCode(translate)
-             << toCode(board, rebirth_)
-             << toCode(!board.at(origin_)->isBlack(), translate) << ")";
+void Move::preWriteFairy(const Board& board, std::ostream& lanBuilder,
+                         int translate) const {
+  lanBuilder << board.getPiece(getOrigin()).getCode(translate)
+             << toCode(board, getOrigin());
+  switch (getKind()) {
+    case ANTI_ANDERNACH_QUIET_MOVE:
+    case ANTI_ANDERNACH_PROMOTION:
+      lanBuilder << "-" << toCode(board, getTarget());
+      break;
+    default:
+      lanBuilder << "x" << toCode(board, getTarget());
+  }
+  switch (getKind()) {
+    case CIRCE_EN_PASSANT:
+    case ANTI_CIRCE_EN_PASSANT:
+    case ANDERNACH_EN_PASSANT:
+    case CIRCE_ANDERNACH_EN_PASSANT:
+    case ANTI_CIRCE_ANDERNACH_EN_PASSANT:
+      lanBuilder << " e.p.";
+      break;
+    case CIRCE_PROMOTION_CAPTURE:
+    case ANTI_CIRCE_PROMOTION_CAPTURE:
+    case ANDERNACH_PROMOTION_CAPTURE:
+    case ANTI_ANDERNACH_PROMOTION:
+    case CIRCE_ANDERNACH_PROMOTION_CAPTURE:
+    case ANTI_CIRCE_ANDERNACH_PROMOTION_CAPTURE:
+      lanBuilder << "="
+                 << Board::toPiece(Board::toCode(getType(), isBlack()))
+                        .getCode(translate);
+      break;
+  }
+  lanBuilder << "(";
+  switch (getKind()) {
+    case CIRCE_CAPTURE:
+    case CIRCE_PROMOTION_CAPTURE:
+      lanBuilder << board.getPiece(getTarget()).getCode(translate)
+                 << toCode(board, getSquare2());
+      break;
+    case CIRCE_EN_PASSANT:
+      lanBuilder << board.getPiece(getStop()).getCode(translate)
+                 << toCode(board, getSquare2());
+      break;
+    case ANTI_CIRCE_CAPTURE:
+    case ANTI_CIRCE_EN_PASSANT:
+      lanBuilder << board.getPiece(getOrigin()).getCode(translate)
+                 << toCode(board, getSquare2());
+      break;
+    case ANTI_CIRCE_PROMOTION_CAPTURE:
+      lanBuilder << Board::toPiece(Board::toCode(getType(), isBlack()))
+                        .getCode(translate)
+                 << toCode(board, getSquare2());
+      break;
+    case ANDERNACH_CAPTURE:
+    case ANDERNACH_EN_PASSANT:
+    case ANDERNACH_PROMOTION_CAPTURE:
+    case ANTI_ANDERNACH_QUIET_MOVE:
+    case ANTI_ANDERNACH_PROMOTION:
+      lanBuilder << toCode(!board.getPiece(getOrigin()).isBlack(), translate);
+      break;
+    case CIRCE_ANDERNACH_CAPTURE:
+    case CIRCE_ANDERNACH_EN_PASSANT:
+    case CIRCE_ANDERNACH_PROMOTION_CAPTURE:
+      lanBuilder << toCode(!board.getPiece(getOrigin()).isBlack(), translate)
+                 << ";" << board.getPiece(getTarget()).getCode(translate)
+                 << toCode(board, getSquare2());
+      break;
+    case ANTI_CIRCE_ANDERNACH_CAPTURE:
+    case ANTI_CIRCE_ANDERNACH_EN_PASSANT:
+      lanBuilder << board.getPiece(getOrigin()).getCode(translate)
+                 << toCode(board, getSquare2())
+                 << toCode(!board.getPiece(getOrigin()).isBlack(), translate);
+      break;
+    case ANTI_CIRCE_ANDERNACH_PROMOTION_CAPTURE:
+      lanBuilder << Board::toPiece(Board::toCode(getType(), isBlack()))
+                        .getCode(translate)
+                 << toCode(board, getSquare2())
+                 << toCode(!board.getPiece(getOrigin()).isBlack(), translate);
+      break;
+  }
+  lanBuilder << ")";
 }
 
 }  // namespace moderato
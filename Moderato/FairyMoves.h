@@ -1,7 +1,7 @@
 /*
  * MIT License
  *
- * Copyright (c) 2025 Ivan Denkovski
+ * Copyright (c) 2024-2025 Ivan Denkovski
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -28,341 +28,96 @@
 
 namespace moderato {
 
-class CirceMove {
- protected:
-  const int rebirth_;
-  const bool castling_;
-  CirceMove(int rebirth, bool castling);
-};
-
-class CirceCapture : public Capture, protected CirceMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void revertPieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(const std::array<std::unique_ptr<Piece>, 128>& board,
-                std::ostream& lanBuilder, int translate) const override;
-
+class CirceCapture : public Move {
  public:
   CirceCapture(int origin, int target, int rebirth, bool castling);
 };
 
-class CirceEnPassant : public EnPassant, protected CirceMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void revertPieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(const std::array<std::unique_ptr<Piece>, 128>& board,
-                std::ostream& lanBuilder, int translate) const override;
-
+class CirceEnPassant : public Move {
  public:
-  CirceEnPassant(int origin, int target, int stop, int rebirth, bool castling);
+  CirceEnPassant(int origin, int target, int rebirth, bool castling);
 };
 
-class CircePromotionCapture : public PromotionCapture, protected CirceMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(
-      std::array<std::unique_ptr<Piece>, 128>& board,
-      std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-      std::stack<std::unique_ptr<Piece>>& table) const override;
-  void revertPieces(
-      std::array<std::unique_ptr<Piece>, 128>& board,
-      std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-      std::stack<std::unique_ptr<Piece>>& table) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      std::ostream& lanBuilder, int translate) const override;
-
+class CircePromotionCapture : public Move {
  public:
-  CircePromotionCapture(int origin, int target, bool black, int order,
-                        int rebirth, bool castling);
-};
-
-class AntiCirceMove {
- protected:
-  const int rebirth_;
-  const bool castling_;
-  AntiCirceMove(int rebirth, bool castling);
+  CircePromotionCapture(int origin, int target, int type, int rebirth,
+                        bool castling);
 };
 
-class AntiCirceCapture : public Capture, protected AntiCirceMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void revertPieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(const std::array<std::unique_ptr<Piece>, 128>& board,
-                std::ostream& lanBuilder, int translate) const override;
-
+class AntiCirceCapture : public Move {
  public:
   AntiCirceCapture(int origin, int target, int rebirth, bool castling);
 };
 
-class AntiCirceEnPassant : public EnPassant, protected AntiCirceMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void revertPieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(const std::array<std::unique_ptr<Piece>, 128>& board,
-                std::ostream& lanBuilder, int translate) const override;
-
+class AntiCirceEnPassant : public Move {
  public:
-  AntiCirceEnPassant(int origin, int target, int stop, int rebirth,
-                     bool castling);
+  AntiCirceEnPassant(int origin, int target, int rebirth, bool castling);
 };
 
-class AntiCircePromotionCapture : public PromotionCapture,
-                                  protected AntiCirceMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(
-      std::array<std::unique_ptr<Piece>, 128>& board,
-      std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-      std::stack<std::unique_ptr<Piece>>& table) const override;
-  void revertPieces(
-      std::array<std::unique_ptr<Piece>, 128>& board,
-      std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-      std::stack<std::unique_ptr<Piece>>& table) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      std::ostream& lanBuilder, int translate) const override;
-
+class AntiCircePromotionCapture : public Move {
  public:
-  AntiCircePromotionCapture(int origin, int target, bool black, int order,
-                            int rebirth, bool castling);
-};
-
-class AndernachMove {
- protected:
-  const bool castling_;
-  AndernachMove(bool castling);
+  AntiCircePromotionCapture(int origin, int target, int type, int rebirth,
+                            bool castling);
 };
 
-class AndernachCapture : public Capture, protected AndernachMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void revertPieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(const std::array<std::unique_ptr<Piece>, 128>& board,
-                std::ostream& lanBuilder, int translate) const override;
-
+class AndernachCapture : public Move {
  public:
   AndernachCapture(int origin, int target, bool castling);
 };
 
-class AndernachEnPassant : public EnPassant, protected AndernachMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void revertPieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(const std::array<std::unique_ptr<Piece>, 128>& board,
-                std::ostream& lanBuilder, int translate) const override;
-
+class AndernachEnPassant : public Move {
  public:
-  AndernachEnPassant(int origin, int target, int stop, bool castling);
+  AndernachEnPassant(int origin, int target, bool castling);
 };
 
-class AndernachPromotionCapture : public PromotionCapture,
-                                  protected AndernachMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(
-      std::array<std::unique_ptr<Piece>, 128>& board,
-      std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-      std::stack<std::unique_ptr<Piece>>& table) const override;
-  void revertPieces(
-      std::array<std::unique_ptr<Piece>, 128>& board,
-      std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-      std::stack<std::unique_ptr<Piece>>& table) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      std::ostream& lanBuilder, int translate) const override;
-
+class AndernachPromotionCapture : public Move {
  public:
-  AndernachPromotionCapture(int origin, int target, bool black, int order,
-                            bool castling);
-};
-
-class AntiAndernachMove {
- protected:
-  const bool castling_;
-  AntiAndernachMove(bool castling);
+  AndernachPromotionCapture(int origin, int target, int type, bool castling);
 };
 
-class AntiAndernachQuietMove : public QuietMove, protected AntiAndernachMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(
-      std::array<std::unique_ptr<Piece>, 128>& board) const override;
-  void revertPieces(
-      std::array<std::unique_ptr<Piece>, 128>& board) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(const std::array<std::unique_ptr<Piece>, 128>& board,
-                std::ostream& lanBuilder, int translate) const override;
-
+class AntiAndernachQuietMove : public Move {
  public:
   AntiAndernachQuietMove(int origin, int target, bool castling);
 };
 
-class AntiAndernachPromotion : public Promotion, protected AntiAndernachMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(
-      std::array<std::unique_ptr<Piece>, 128>& board,
-      std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box)
-      const override;
-  void revertPieces(
-      std::array<std::unique_ptr<Piece>, 128>& board,
-      std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box)
-      const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      std::ostream& lanBuilder, int translate) const override;
-
+class AntiAndernachPromotion : public Move {
  public:
-  AntiAndernachPromotion(int origin, int target, bool black, int order,
-                         bool castling);
-};
-
-class CirceAndernachMove {
- protected:
-  const int rebirth_;
-  const bool castling_;
-  const bool castling2_;
-  CirceAndernachMove(int rebirth, bool castling, bool castling2);
+  AntiAndernachPromotion(int origin, int target, int type, bool castling);
 };
 
-class CirceAndernachCapture : public Capture, protected CirceAndernachMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void revertPieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(const std::array<std::unique_ptr<Piece>, 128>& board,
-                std::ostream& lanBuilder, int translate) const override;
-
+class CirceAndernachCapture : public Move {
  public:
   CirceAndernachCapture(int origin, int target, int rebirth, bool castling,
                         bool castling2);
 };
 
-class CirceAndernachEnPassant : public EnPassant, protected CirceAndernachMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void revertPieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(const std::array<std::unique_ptr<Piece>, 128>& board,
-                std::ostream& lanBuilder, int translate) const override;
-
+class CirceAndernachEnPassant : public Move {
  public:
-  CirceAndernachEnPassant(int origin, int target, int stop, int rebirth,
-                          bool castling, bool castling2);
+  CirceAndernachEnPassant(int origin, int target, int rebirth, bool castling,
+                          bool castling2);
 };
 
-class CirceAndernachPromotionCapture : public PromotionCapture,
-                                       protected CirceAndernachMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(
-      std::array<std::unique_ptr<Piece>, 128>& board,
-      std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-      std::stack<std::unique_ptr<Piece>>& table) const override;
-  void revertPieces(
-      std::array<std::unique_ptr<Piece>, 128>& board,
-      std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-      std::stack<std::unique_ptr<Piece>>& table) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      std::ostream& lanBuilder, int translate) const override;
-
+class CirceAndernachPromotionCapture : public Move {
  public:
-  CirceAndernachPromotionCapture(int origin, int target, bool black, int order,
-                                 int rebirth, bool castling, bool castling2);
-};
-
-class AntiCirceAndernachMove {
- protected:
-  const int rebirth_;
-  const bool castling_;
-  AntiCirceAndernachMove(int rebirth, bool castling);
+  CirceAndernachPromotionCapture(int origin, int target, int type, int rebirth,
+                                 bool castling, bool castling2);
 };
 
-class AntiCirceAndernachCapture : public Capture,
-                                  protected AntiCirceAndernachMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void revertPieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(const std::array<std::unique_ptr<Piece>, 128>& board,
-                std::ostream& lanBuilder, int translate) const override;
-
+class AntiCirceAndernachCapture : public Move {
  public:
   AntiCirceAndernachCapture(int origin, int target, int rebirth, bool castling);
 };
 
-class AntiCirceAndernachEnPassant : public EnPassant,
-                                    protected AntiCirceAndernachMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void revertPieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(const std::array<std::unique_ptr<Piece>, 128>& board,
-                std::ostream& lanBuilder, int translate) const override;
-
+class AntiCirceAndernachEnPassant : public Move {
  public:
-  AntiCirceAndernachEnPassant(int origin, int target, int stop, int rebirth,
+  AntiCirceAndernachEnPassant(int origin, int target, int rebirth,
                               bool castling);
 };
 
-class AntiCirceAndernachPromotionCapture : public PromotionCapture,
-                                           protected AntiCirceAndernachMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(
-      std::array<std::unique_ptr<Piece>, 128>& board,
-      std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-      std::stack<std::unique_ptr<Piece>>& table) const override;
-  void revertPieces(
-      std::array<std::unique_ptr<Piece>, 128>& board,
-      std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-      std::stack<std::unique_ptr<Piece>>& table) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      std::ostream& lanBuilder, int translate) const override;
-
+class AntiCirceAndernachPromotionCapture : public Move {
  public:
-  AntiCirceAndernachPromotionCapture(int origin, int target, bool black,
-                                     int order, int rebirth, bool castling);
+  AntiCirceAndernachPromotionCapture(int origin, int target, int type,
+                                     int rebirth, bool castling);
 };
 
 }  // namespace moderato
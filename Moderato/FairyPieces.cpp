@@ -27,9 +27,8 @@
 namespace moderato {
 
 FairyPiece::FairyPiece(bool black) : Piece(black) {}
-int FairyPiece::findRebirthSquare(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int square,
-    bool opposite) const {
+int FairyPiece::findRebirthSquare(const Board& board, int square,
+                                  bool opposite) const {
   return (square / 16) * 16 + (black_ != opposite ? 0 : 7);
 }
 
@@ -41,96 +40,75 @@ bool Grasshopper::isBlack() const { return Piece::isBlack(); }
 bool Nightrider::isBlack() const { return Piece::isBlack(); }
 bool Amazon::isBlack() const { return Piece::isBlack(); }
 
-std::vector<int>& Grasshopper::hops(
-    const std::array<std::unique_ptr<Piece>, 128>& board) {
+std::vector<int>& Grasshopper::hops(const Board& board) {
   static std::vector<int> hops = {-17, -16, -15, -1, 1, 15, 16, 17};
   return hops;
 }
-const std::vector<int>& Grasshopper::getHops(
-    const std::array<std::unique_ptr<Piece>, 128>& board) const {
+const std::vector<int>& Grasshopper::getHops(const Board& board) const {
   return hops(board);
 }
 bool Grasshopper::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  return Hopper::generateMoves(board, origin, moveFactory, moves);
-}
-bool Grasshopper::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory) const {
-  return Hopper::generateMoves(board, origin, moveFactory);
+    const Board& board, const std::array<int, 20>& box,
+    const std::pair<int, int>& state, int origin,
+    const MoveFactory& moveFactory, MoveList& moves, int stage) const {
+  return Hopper::generateMoves(board, origin, moveFactory, moves, stage);
+}
+bool Grasshopper::generateMoves(const Board& board,
+                                const std::array<int, 20>& box,
+                                const std::pair<int, int>& state, int origin,
+                                const MoveFactory& moveFactory,
+                                LegalMoveCounter& counter) const {
+  return Hopper::generateMoves(board, origin, moveFactory, counter);
 }
 
-std::vector<int>& Nightrider::rides(
-    const std::array<std::unique_ptr<Piece>, 128>& board) {
+std::vector<int>& Nightrider::rides(const Board& board) {
   static std::vector<int> rides = {-33, -31, -18, -14, 14, 18, 31, 33};
   return rides;
 }
-const std::vector<int>& Nightrider::getRides(
-    const std::array<std::unique_ptr<Piece>, 128>& board) const {
+const std::vector<int>& Nightrider::getRides(const Board& board) const {
   return rides(board);
 }
 bool Nightrider::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  return Rider::generateMoves(board, origin, moveFactory, moves);
-}
-bool Nightrider::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory) const {
-  return Rider::generateMoves(board, origin, moveFactory);
+    const Board& board, const std::array<int, 20>& box,
+    const std::pair<int, int>& state, int origin,
+    const MoveFactory& moveFactory, MoveList& moves, int stage) const {
+  return Rider::generateMoves(board, origin, moveFactory, moves, stage);
+}
+bool Nightrider::generateMoves(const Board& board,
+                               const std::array<int, 20>& box,
+                               const std::pair<int, int>& state, int origin,
+                               const MoveFactory& moveFactory,
+                               LegalMoveCounter& counter) const {
+  return Rider::generateMoves(board, origin, moveFactory, counter);
 }
 
-std::vector<int>& Amazon::rides(
-    const std::array<std::unique_ptr<Piece>, 128>& board) {
+std::vector<int>& Amazon::rides(const Board& board) {
   static std::vector<int> rides = {-17, -16, -15, -1, 1, 15, 16, 17};
   return rides;
 }
-const std::vector<int>& Amazon::getRides(
-    const std::array<std::unique_ptr<Piece>, 128>& board) const {
+const std::vector<int>& Amazon::getRides(const Board& board) const {
   return rides(board);
 }
-std::vector<int>& Amazon::leaps(
-    const std::array<std::unique_ptr<Piece>, 128>& board) {
+std::vector<int>& Amazon::leaps(const Board& board) {
   static std::vector<int> leaps = {-33, -31, -18, -14, 14, 18, 31, 33};
   return leaps;
 }
-const std::vector<int>& Amazon::getLeaps(
-    const std::array<std::unique_ptr<Piece>, 128>& board) const {
+const std::vector<int>& Amazon::getLeaps(const Board& board) const {
   return leaps(board);
 }
-bool Amazon::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  return Rider::generateMoves(board, origin, moveFactory, moves) &&
-         Leaper::generateMoves(board, origin, moveFactory, moves);
-}
-bool Amazon::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory) const {
-  return Rider::generateMoves(board, origin, moveFactory) &&
-         Leaper::generateMoves(board, origin, moveFactory);
+bool Amazon::generateMoves(const Board& board, const std::array<int, 20>& box,
+                           const std::pair<int, int>& state, int origin,
+                           const MoveFactory& moveFactory, MoveList& moves,
+                           int stage) const {
+  return Rider::generateMoves(board, origin, moveFactory, moves, stage) &&
+         Leaper::generateMoves(board, origin, moveFactory, moves, stage);
+}
+bool Amazon::generateMoves(const Board& board, const std::array<int, 20>& box,
+                           const std::pair<int, int>& state, int origin,
+                           const MoveFactory& moveFactory,
+                           LegalMoveCounter& counter) const {
+  return Rider::generateMoves(board, origin, moveFactory, counter) &&
+         Leaper::generateMoves(board, origin, moveFactory, counter);
 }
 
 std::string Grasshopper::code(int translate) {
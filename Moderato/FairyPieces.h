@@ -33,91 +33,68 @@ class FairyPiece : public Piece {
   FairyPiece(bool black);
 
  public:
-  int findRebirthSquare(const std::array<std::unique_ptr<Piece>, 128>& board,
-                        int square, bool opposite) const override;
+  int findRebirthSquare(const Board& board, int square,
+                        bool opposite) const override;
 };
 
 class Grasshopper : public FairyPiece, Hopper {
-  static std::vector<int>& hops(
-      const std::array<std::unique_ptr<Piece>, 128>& board);
-  const std::vector<int>& getHops(
-      const std::array<std::unique_ptr<Piece>, 128>& board) const override;
+  static std::vector<int>& hops(const Board& board);
+  const std::vector<int>& getHops(const Board& board) const override;
   std::string getName() const override;
 
  public:
   Grasshopper(bool black);
   bool isBlack() const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory, MoveList& moves,
+                     int stage) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory,
+                     LegalMoveCounter& counter) const override;
   static std::string code(int translate);
   std::string getCode(int translate) const override;
 };
 
 class Nightrider : public FairyPiece, Rider {
-  static std::vector<int>& rides(
-      const std::array<std::unique_ptr<Piece>, 128>& board);
-  const std::vector<int>& getRides(
-      const std::array<std::unique_ptr<Piece>, 128>& board) const override;
+  static std::vector<int>& rides(const Board& board);
+  const std::vector<int>& getRides(const Board& board) const override;
   std::string getName() const override;
 
  public:
   Nightrider(bool black);
   bool isBlack() const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory, MoveList& moves,
+                     int stage) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory,
+                     LegalMoveCounter& counter) const override;
   static std::string code(int translate);
   std::string getCode(int translate) const override;
 };
 
 class Amazon : public FairyPiece, Rider, Leaper {
-  static std::vector<int>& rides(
-      const std::array<std::unique_ptr<Piece>, 128>& board);
-  const std::vector<int>& getRides(
-      const std::array<std::unique_ptr<Piece>, 128>& board) const override;
-  static std::vector<int>& leaps(
-      const std::array<std::unique_ptr<Piece>, 128>& board);
-  const std::vector<int>& getLeaps(
-      const std::array<std::unique_ptr<Piece>, 128>& board) const override;
+  static std::vector<int>& rides(const Board& board);
+  const std::vector<int>& getRides(const Board& board) const override;
+  static std::vector<int>& leaps(const Board& board);
+  const std::vector<int>& getLeaps(const Board& board) const override;
   std::string getName() const override;
 
  public:
   Amazon(bool black);
   bool isBlack() const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory, MoveList& moves,
+                     int stage) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory,
+                     LegalMoveCounter& counter) const override;
   static std::string code(int translate);
   std::string getCode(int translate) const override;
 };
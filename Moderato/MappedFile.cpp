@@ -0,0 +1,126 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Ivan Denkovski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "MappedFile.h"
+
+#if _MSC_VER
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace moderato {
+
+#if _MSC_VER
+MappedFile::MappedFile(const std::string& fileName, std::size_t size,
+                       std::uint64_t magic) {
+  HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ | GENERIC_WRITE,
+                            FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                            OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return;
+  }
+  OVERLAPPED overlapped = {};
+  LARGE_INTEGER fileSize;
+  std::uint64_t header = 0;
+  DWORD nRead = 0;
+  if (LockFileEx(file, LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY, 0,
+                 MAXDWORD, MAXDWORD, &overlapped) &&
+      GetFileSizeEx(file, &fileSize) &&
+      (fileSize.QuadPart == 0 ||
+       (ReadFile(file, &header, sizeof(header), &nRead, nullptr) &&
+        nRead == sizeof(header) && header == magic))) {
+    ULARGE_INTEGER mappingSize;
+    mappingSize.QuadPart = size;
+    HANDLE mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READWRITE, mappingSize.HighPart,
+                           mappingSize.LowPart, nullptr);
+    if (mapping) {
+      data_ = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+      CloseHandle(mapping);
+    }
+  }
+  if (!data_) {
+    CloseHandle(file);
+    return;
+  }
+  file_ = file;
+  size_ = size;
+  new_ = fileSize.QuadPart == 0;
+}
+MappedFile::~MappedFile() {
+  if (data_) {
+    UnmapViewOfFile(data_);
+  }
+  if (file_) {
+    CloseHandle(file_);
+  }
+}
+#else
+MappedFile::MappedFile(const std::string& fileName, std::size_t size,
+                       std::uint64_t magic) {
+  int file = open(fileName.c_str(), O_RDWR | O_CREAT, 0644);
+  if (file < 0) {
+    return;
+  }
+  struct stat status;
+  std::uint64_t header = 0;
+  if (flock(file, LOCK_EX | LOCK_NB) == 0 && fstat(file, &status) == 0 &&
+      (status.st_size == 0 ||
+       (pread(file, &header, sizeof(header), 0) == sizeof(header) &&
+        header == magic)) &&
+      (static_cast<std::size_t>(status.st_size) >= size ||
+       ftruncate(file, static_cast<off_t>(size)) == 0)) {
+    void* data =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    if (data != MAP_FAILED) {
+      data_ = data;
+    }
+  }
+  if (!data_) {
+    close(file);
+    return;
+  }
+  file_ = file;
+  size_ = size;
+  new_ = status.st_size == 0;
+}
+MappedFile::~MappedFile() {
+  if (data_) {
+    munmap(data_, size_);
+  }
+  if (file_ >= 0) {
+    close(file_);
+  }
+}
+#endif
+void* MappedFile::getData() const { return data_; }
+bool MappedFile::isNew() const { return new_; }
+
+}  // namespace moderato
@@ -24,80 +24,116 @@
 
 #include "Move.h"
 
+#include <cassert>
+#include <stdexcept>
+
 #include "Position.h"
+#include "Zobrist.h"
 
 namespace moderato {
 
+Move::Move(int kind, int origin, int target, int square2, int type,
+           bool castling, bool castling2)
+    : bits_(origin | target << 7 | square2 << 14 | type << 21 | kind << 25 |
+            static_cast<std::uint32_t>(castling) << 30 |
+            static_cast<std::uint32_t>(castling2) << 31) {}
+int Move::getKind() const { return bits_ >> 25 & 31; }
+int Move::getOrigin() const { return bits_ & 127; }
+int Move::getTarget() const { return bits_ >> 7 & 127; }
+int Move::getSquare2() const { return bits_ >> 14 & 127; }
+int Move::getTarget2() const { return (getOrigin() + getTarget()) / 2; }
+int Move::getStop() const {
+  if (getKind() == DOUBLE_STEP) {
+    return (getOrigin() + getTarget()) / 2;
+  }
+  return getTarget() / 16 * 16 + getOrigin() % 16;
+}
+int Move::getType() const { return bits_ >> 21 & 15; }
+bool Move::isBlack() const { return getTarget() % 16 == 0; }
+bool Move::isCastling() const { return bits_ >> 30 & 1; }
+bool Move::isCastling2() const { return bits_ >> 31 & 1; }
+bool Move::operator==(const Move& move) const { return bits_ == move.bits_; }
 std::ostream& operator<<(std::ostream& output, const Move& move) {
   move.write(output);
   return output;
 }
-Move::~Move() {}
-bool Move::make(Position& position,
-                std::vector<std::unique_ptr<Move>>& pseudoLegalMoves,
-                std::ostream& lanBuilder, int translate) const {
-  preWrite(position, lanBuilder, translate);
-  bool result = preMake(position);
-  updatePieces(position);
-  updateState(position);
-  return result && position.isLegal(pseudoLegalMoves);
-}
-bool Move::make(Position& position,
-                std::vector<std::unique_ptr<Move>>& pseudoLegalMoves) const {
-  bool result = preMake(position);
-  updatePieces(position);
-  updateState(position);
-  return result && position.isLegal(pseudoLegalMoves);
+bool Move::make(Position& position, std::ostream& lanBuilder,
+                int translate) const {
+  preWrite(position.getBoard(), lanBuilder, translate);
+  return make(position);
 }
 bool Move::make(Position& position) const {
   bool result = preMake(position);
   updatePieces(position);
   updateState(position);
+  position.getChecks()[position.getPly()] = -1;
+  assert(position.getKey() == position.computeKey());
   return result && position.isLegal();
 }
 void Move::unmake(Position& position) const {
   revertState(position);
   revertPieces(position);
+  assert(position.getKey() == position.computeKey());
 }
-
-void NullMove::write(std::ostream& output) const { output << "NullMove[]"; }
-bool NullMove::preMake(Position& position) const { return true; }
-void NullMove::updatePieces(Position& position) const {}
-void NullMove::revertPieces(Position& position) const {}
-void NullMove::updateState(Position& position) const {
+void Move::updatePieces(Position& position) const {
+  updatePieces(position.getBoard(), position.getBox(),
+               position.getTable().at(position.getPly()));
+}
+void Move::revertPieces(Position& position) const {
+  revertPieces(position.getBoard(), position.getBox(),
+               position.getTable()[position.getPly()]);
+}
+void Move::updateState(Position& position) const {
   updateState(position.isBlackToMove(), position.getState(),
-              position.getMemory());
+              position.getMemory().at(position.getPly()++),
+              position.getStateKey());
 }
-void NullMove::updateState(
-    bool& blackToMove, std::pair<std::set<int>, std::shared_ptr<int>>& state,
-    std::stack<std::pair<std::set<int>, std::shared_ptr<int>>>& memory) const {
-  memory.push(state);
+void Move::updateState(bool& blackToMove, std::pair<int, int>& state,
+                       std::pair<int, int>& memory, std::uint64_t& key) const {
+  memory = state;
+  key ^= hashState(state);
   updateCastlings(state.first);
   updateEnPassant(state.second);
   blackToMove = !blackToMove;
+  key ^= hashState(state) ^ hashSide();
 }
-void NullMove::updateCastlings(std::set<int>& castlings) const {}
-void NullMove::updateEnPassant(std::shared_ptr<int>& enPassant) const {
-  enPassant.reset();
+void Move::updateEnPassant(int& enPassant) const {
+  if (getKind() == DOUBLE_STEP) {
+    enPassant = getStop();
+  } else {
+    enPassant = -1;
+  }
 }
-void NullMove::revertState(Position& position) const {
+void Move::revertState(Position& position) const {
   revertState(position.isBlackToMove(), position.getState(),
-              position.getMemory());
+              position.getMemory()[--position.getPly()],
+              position.getStateKey());
 }
-void NullMove::revertState(
-    bool& blackToMove, std::pair<std::set<int>, std::shared_ptr<int>>& state,
-    std::stack<std::pair<std::set<int>, std::shared_ptr<int>>>& memory) const {
+void Move::revertState(bool& blackToMove, std::pair<int, int>& state,
+                       std::pair<int, int>& memory, std::uint64_t& key) const {
+  key ^= hashState(state) ^ hashSide();
   blackToMove = !blackToMove;
-  state = std::move(memory.top());
-  memory.pop();
+  state = memory;
+  key ^= hashState(state);
 }
-void NullMove::preWrite(Position& position, std::ostream& lanBuilder,
-                        int translate) const {
-  lanBuilder << "null";
+
+NullMove::NullMove() : Move(NULL_MOVE, 0, 0, 0, 0, false, false) {}
+
+void MoveList::add(const Move& move) {
+  if (size_ == static_cast<int>(moves_.size())) {
+    throw std::length_error("Move list overflow.");
+  }
+  moves_[size_++] = move;
 }
+void MoveList::clear() { size_ = 0; }
+void MoveList::resize(int size) { size_ = size; }
+int MoveList::size() const { return size_; }
+Move* MoveList::begin() { return moves_.data(); }
+Move* MoveList::end() { return moves_.data() + size_; }
+const Move* MoveList::begin() const { return moves_.data(); }
+const Move* MoveList::end() const { return moves_.data() + size_; }
 
-void postWrite(Position& position,
-               const std::vector<std::unique_ptr<Move>>& pseudoLegalMoves,
+void postWrite(Position& position, const MoveList& pseudoLegalMoves,
                std::ostream& lanBuilder) {
   int nChecks = position.isCheck();
   bool terminal = position.isTerminal(pseudoLegalMoves);
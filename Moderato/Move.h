@@ -24,60 +24,118 @@
 
 #pragma once
 
-#include <memory>
+#include <array>
+#include <cstdint>
 #include <ostream>
-#include <set>
-#include <stack>
 #include <utility>
-#include <vector>
 
 namespace moderato {
 
+class Board;
+class MoveList;
 class Position;
 
 class Move {
-  virtual void write(std::ostream& output) const = 0;
-  virtual bool preMake(Position& position) const = 0;
-  virtual void updatePieces(Position& position) const = 0;
-  virtual void revertPieces(Position& position) const = 0;
-  virtual void updateState(Position& position) const = 0;
-  virtual void revertState(Position& position) const = 0;
-  virtual void preWrite(Position& position, std::ostream& lanBuilder,
-                        int translate) const = 0;
+  std::uint32_t bits_;
+  int getSquare2() const;
+  int getTarget2() const;
+  int getStop() const;
+  int getType() const;
+  bool isBlack() const;
+  bool isCastling() const;
+  bool isCastling2() const;
+  void write(std::ostream& output) const;
+  void writeFairy(std::ostream& output) const;
+  bool preMake(Position& position) const;
+  void updatePieces(Position& position) const;
+  void updatePieces(Board& board, std::array<int, 20>& box,
+                    unsigned char& table) const;
+  void updateFairyPieces(Board& board, std::array<int, 20>& box,
+                         unsigned char& table) const;
+  void revertPieces(Position& position) const;
+  void revertPieces(Board& board, std::array<int, 20>& box,
+                    unsigned char& table) const;
+  void revertFairyPieces(Board& board, std::array<int, 20>& box,
+                         unsigned char& table) const;
+  void updateState(Position& position) const;
+  void updateState(bool& blackToMove, std::pair<int, int>& state,
+                   std::pair<int, int>& memory, std::uint64_t& key) const;
+  void updateCastlings(int& castlings) const;
+  void updateFairyCastlings(int& castlings) const;
+  void updateEnPassant(int& enPassant) const;
+  void revertState(Position& position) const;
+  void revertState(bool& blackToMove, std::pair<int, int>& state,
+                   std::pair<int, int>& memory, std::uint64_t& key) const;
+  void preWrite(const Board& board, std::ostream& lanBuilder,
+                int translate) const;
+  void preWriteFairy(const Board& board, std::ostream& lanBuilder,
+                     int translate) const;
+
+ protected:
+  Move(int kind, int origin, int target, int square2, int type, bool castling,
+       bool castling2);
 
  public:
-  friend std::ostream& operator<<(std::ostream& output, const Move& move);
-  virtual ~Move();
-  bool make(Position& position,
-            std::vector<std::unique_ptr<Move>>& pseudoLegalMoves,
-            std::ostream& lanBuilder, int translate) const;
-  bool make(Position& position,
-            std::vector<std::unique_ptr<Move>>& pseudoLegalMoves) const;
+  enum {
+    NULL_MOVE,
+    QUIET_MOVE,
+    CAPTURE,
+    LONG_CASTLING,
+    SHORT_CASTLING,
+    DOUBLE_STEP,
+    EN_PASSANT,
+    PROMOTION,
+    PROMOTION_CAPTURE,
+    CIRCE_CAPTURE,
+    CIRCE_EN_PASSANT,
+    CIRCE_PROMOTION_CAPTURE,
+    ANTI_CIRCE_CAPTURE,
+    ANTI_CIRCE_EN_PASSANT,
+    ANTI_CIRCE_PROMOTION_CAPTURE,
+    ANDERNACH_CAPTURE,
+    ANDERNACH_EN_PASSANT,
+    ANDERNACH_PROMOTION_CAPTURE,
+    ANTI_ANDERNACH_QUIET_MOVE,
+    ANTI_ANDERNACH_PROMOTION,
+    CIRCE_ANDERNACH_CAPTURE,
+    CIRCE_ANDERNACH_EN_PASSANT,
+    CIRCE_ANDERNACH_PROMOTION_CAPTURE,
+    ANTI_CIRCE_ANDERNACH_CAPTURE,
+    ANTI_CIRCE_ANDERNACH_EN_PASSANT,
+    ANTI_CIRCE_ANDERNACH_PROMOTION_CAPTURE
+  };
+  Move() = default;
+  int getKind() const;
+  int getOrigin() const;
+  int getTarget() const;
+  bool operator==(const Move& move) const;
+  bool make(Position& position, std::ostream& lanBuilder, int translate) const;
   bool make(Position& position) const;
   void unmake(Position& position) const;
+  friend std::ostream& operator<<(std::ostream& output, const Move& move);
 };
 
 class NullMove : public Move {
-  void write(std::ostream& output) const override;
-  bool preMake(Position& position) const override;
-  void updatePieces(Position& position) const override;
-  void revertPieces(Position& position) const override;
-  void updateState(Position& position) const override;
-  void updateState(
-      bool& blackToMove, std::pair<std::set<int>, std::shared_ptr<int>>& state,
-      std::stack<std::pair<std::set<int>, std::shared_ptr<int>>>& memory) const;
-  virtual void updateCastlings(std::set<int>& castlings) const;
-  virtual void updateEnPassant(std::shared_ptr<int>& enPassant) const;
-  void revertState(Position& position) const override;
-  void revertState(
-      bool& blackToMove, std::pair<std::set<int>, std::shared_ptr<int>>& state,
-      std::stack<std::pair<std::set<int>, std::shared_ptr<int>>>& memory) const;
-  void preWrite(Position& position, std::ostream& lanBuilder,
-                int translate) const override;
+ public:
+  NullMove();
+};
+
+class MoveList {
+  std::array<Move, 1024> moves_;
+  int size_ = 0;
+
+ public:
+  void add(const Move& move);
+  void clear();
+  void resize(int size);
+  int size() const;
+  Move* begin();
+  Move* end();
+  const Move* begin() const;
+  const Move* end() const;
 };
 
-void postWrite(Position& position,
-               const std::vector<std::unique_ptr<Move>>& pseudoLegalMoves,
+void postWrite(Position& position, const MoveList& pseudoLegalMoves,
                std::ostream& lanBuilder);
 
 }  // namespace moderato
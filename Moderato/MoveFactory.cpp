@@ -32,85 +32,61 @@ MoveFactory::~MoveFactory() {}
 void MoveFactory::write(std::ostream& output) const {
   output << "MoveFactory[]";
 }
-void MoveFactory::generateQuietMove(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, std::vector<std::unique_ptr<Move>>& moves) const {
-  moves.push_back(std::make_unique<QuietMove>(origin, target));
+void MoveFactory::generateQuietMove(const Board& board, int origin, int target,
+                                    MoveList& moves) const {
+  moves.add(QuietMove(origin, target));
 }
-bool MoveFactory::generateCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, std::vector<std::unique_ptr<Move>>& moves) const {
-  if (board.at(target)->isRoyal()) {
+bool MoveFactory::generateCapture(const Board& board, int origin, int target,
+                                  MoveList& moves) const {
+  if (board.getPiece(target).isRoyal()) {
     return false;
   }
-  moves.push_back(std::make_unique<Capture>(origin, target));
+  moves.add(Capture(origin, target));
   return true;
 }
-bool MoveFactory::generateCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target) const {
-  return !board.at(target)->isRoyal();
+bool MoveFactory::generateCapture(const Board& board, int origin,
+                                  int target) const {
+  return !board.getPiece(target).isRoyal();
 }
-void MoveFactory::generateLongCastling(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int origin2, int target2,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  moves.push_back(
-      std::make_unique<LongCastling>(origin, target, origin2, target2));
+void MoveFactory::generateLongCastling(const Board& board, int origin,
+                                       int target, int origin2, int target2,
+                                       MoveList& moves) const {
+  moves.add(LongCastling(origin, target, origin2));
 }
-void MoveFactory::generateShortCastling(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int origin2, int target2,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  moves.push_back(
-      std::make_unique<ShortCastling>(origin, target, origin2, target2));
+void MoveFactory::generateShortCastling(const Board& board, int origin,
+                                        int target, int origin2, int target2,
+                                        MoveList& moves) const {
+  moves.add(ShortCastling(origin, target, origin2));
 }
-void MoveFactory::generateDoubleStep(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop, std::vector<std::unique_ptr<Move>>& moves) const {
-  moves.push_back(std::make_unique<DoubleStep>(origin, target, stop));
+void MoveFactory::generateDoubleStep(const Board& board, int origin, int target,
+                                     int stop, MoveList& moves) const {
+  moves.add(DoubleStep(origin, target));
 }
-bool MoveFactory::generateEnPassant(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop, std::vector<std::unique_ptr<Move>>& moves) const {
-  if (board.at(stop)->isRoyal()) {
+bool MoveFactory::generateEnPassant(const Board& board, int origin, int target,
+                                    int stop, MoveList& moves) const {
+  if (board.getPiece(stop).isRoyal()) {
     return false;
   }
-  moves.push_back(std::make_unique<EnPassant>(origin, target, stop));
+  moves.add(EnPassant(origin, target));
   return true;
 }
-bool MoveFactory::generateEnPassant(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-    int target, int stop) const {
-  return !board.at(stop)->isRoyal();
+void MoveFactory::generatePromotion(const Board& board, int origin, int target,
+                                    bool black, int type,
+                                    MoveList& moves) const {
+  moves.add(Promotion(origin, target, type));
 }
-void MoveFactory::generatePromotion(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  moves.push_back(std::make_unique<Promotion>(origin, target, black, order));
-}
-bool MoveFactory::generatePromotionCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  if (board.at(target)->isRoyal()) {
+bool MoveFactory::generatePromotionCapture(const Board& board, int origin,
+                                           int target, bool black, int type,
+                                           MoveList& moves) const {
+  if (board.getPiece(target).isRoyal()) {
     return false;
   }
-  moves.push_back(
-      std::make_unique<PromotionCapture>(origin, target, black, order));
+  moves.add(PromotionCapture(origin, target, type));
   return true;
 }
 bool MoveFactory::generatePromotionCapture(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    int origin, int target, bool black, int order) const {
-  return !board.at(target)->isRoyal();
+    const Board& board, int origin, int target, bool black, int type) const {
+  return !board.getPiece(target).isRoyal();
 }
 std::ostream& operator<<(std::ostream& output, const MoveFactory& moveFactory) {
   moveFactory.write(output);
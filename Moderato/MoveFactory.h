@@ -24,58 +24,75 @@
 
 #pragma once
 
-#include "Piece.h"
+#include <memory>
+
+#include "Board.h"
 
 namespace moderato {
 
+class LegalMoveCounter;
+
 class MoveFactory {
   virtual void write(std::ostream& output) const;
 
  public:
   virtual ~MoveFactory();
-  virtual void generateQuietMove(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, std::vector<std::unique_ptr<Move>>& moves) const;
-  virtual bool generateCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, std::vector<std::unique_ptr<Move>>& moves) const;
-  virtual bool generateCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target) const;
-  virtual void generateLongCastling(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int origin2, int target2,
-      std::vector<std::unique_ptr<Move>>& moves) const;
-  virtual void generateShortCastling(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int origin2, int target2,
-      std::vector<std::unique_ptr<Move>>& moves) const;
-  virtual void generateDoubleStep(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int stop, std::vector<std::unique_ptr<Move>>& moves) const;
-  virtual bool generateEnPassant(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int stop, std::vector<std::unique_ptr<Move>>& moves) const;
-  virtual bool generateEnPassant(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int origin,
-      int target, int stop) const;
-  virtual void generatePromotion(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order,
-      std::vector<std::unique_ptr<Move>>& moves) const;
-  virtual bool generatePromotionCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order,
-      std::vector<std::unique_ptr<Move>>& moves) const;
-  virtual bool generatePromotionCapture(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      int origin, int target, bool black, int order) const;
+  virtual bool generateLeaps(const Board& board, int origin, bool black,
+                             const std::vector<int>& leaps, MoveList& moves,
+                             int stage) const = 0;
+  virtual bool generateLeaps(const Board& board, int origin, bool black,
+                             const std::vector<int>& leaps,
+                             LegalMoveCounter& counter) const = 0;
+  virtual bool generateRides(const Board& board, int origin, bool black,
+                             const std::vector<int>& rides, MoveList& moves,
+                             int stage) const = 0;
+  virtual bool generateRides(const Board& board, int origin, bool black,
+                             const std::vector<int>& rides,
+                             LegalMoveCounter& counter) const = 0;
+  virtual bool generateHops(const Board& board, int origin, bool black,
+                            const std::vector<int>& hops, MoveList& moves,
+                            int stage) const = 0;
+  virtual bool generateHops(const Board& board, int origin, bool black,
+                            const std::vector<int>& hops,
+                            LegalMoveCounter& counter) const = 0;
+  virtual bool generatePawnMoves(
+      const Board& board, const std::array<int, 20>& box,
+      const std::pair<int, int>& state, int origin, bool black, MoveList& moves,
+      int stage) const = 0;
+  virtual bool generatePawnMoves(
+      const Board& board, const std::array<int, 20>& box,
+      const std::pair<int, int>& state, int origin, bool black,
+      LegalMoveCounter& counter) const = 0;
+  virtual void generateCastlings(const Board& board, int castlings, int origin,
+                                 MoveList& moves) const = 0;
+  virtual bool generateCastlings(const Board& board, int castlings, int origin,
+                                 LegalMoveCounter& counter) const = 0;
+  virtual bool isAttacked(const Board& board, const std::array<int, 20>& box,
+                          int square, bool black) const = 0;
+  virtual int countAttacks(const Board& board, const std::array<int, 20>& box,
+                           int square, bool black) const = 0;
+  virtual bool hasLocalMoves() const = 0;
+  virtual bool hasLocalChecks() const = 0;
+  virtual std::unique_ptr<MoveFactory> clone() const = 0;
+  void generateQuietMove(const Board& board, int origin, int target,
+                         MoveList& moves) const;
+  bool generateCapture(const Board& board, int origin, int target,
+                       MoveList& moves) const;
+  bool generateCapture(const Board& board, int origin, int target) const;
+  void generateLongCastling(const Board& board, int origin, int target,
+                            int origin2, int target2, MoveList& moves) const;
+  void generateShortCastling(const Board& board, int origin, int target,
+                             int origin2, int target2, MoveList& moves) const;
+  void generateDoubleStep(const Board& board, int origin, int target, int stop,
+                          MoveList& moves) const;
+  bool generateEnPassant(const Board& board, int origin, int target, int stop,
+                         MoveList& moves) const;
+  void generatePromotion(const Board& board, int origin, int target, bool black,
+                         int type, MoveList& moves) const;
+  bool generatePromotionCapture(const Board& board, int origin, int target,
+                                bool black, int type, MoveList& moves) const;
+  bool generatePromotionCapture(const Board& board, int origin, int target,
+                                bool black, int type) const;
   friend std::ostream& operator<<(std::ostream& output,
                                   const MoveFactory& moveFactory);
 };
@@ -0,0 +1,98 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024-2025 Ivan Denkovski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "MoveGenerator.h"
+
+namespace moderato {
+
+MoveGenerator::MoveGenerator(Position& position, MoveOrdering* moveOrdering,
+                             bool defence, bool checks)
+    : position_(&position),
+      moves_(&position.getMoves(position.getPly())),
+      stage_(0),
+      moveOrdering_(moveOrdering),
+      defence_(defence),
+      checks_(checks) {
+  moves_->clear();
+}
+MoveGenerator::MoveGenerator(Position& position, bool checks)
+    : MoveGenerator(position, nullptr, false, checks) {}
+MoveGenerator::MoveGenerator(MoveList& moves)
+    : position_(nullptr),
+      moves_(&moves),
+      stage_(Piece::ALL_MOVES),
+      moveOrdering_(nullptr),
+      defence_(false),
+      checks_(false) {}
+bool MoveGenerator::generate() {
+  if (stage_ == Piece::ALL_MOVES) {
+    return false;
+  }
+  int stage = stage_ ? Piece::QUIET_MOVES : Piece::CAPTURES;
+  int size = moves_->size();
+  if (!(checks_ ? position_->generateChecks(*moves_, stage)
+                : position_->generateMoves(*moves_, stage))) {
+    moves_->clear();
+    stage_ = Piece::ALL_MOVES;
+    return false;
+  }
+  if (moveOrdering_) {
+    moveOrdering_->sort(*position_, moves_->begin() + size, moves_->end(),
+                        defence_);
+  }
+  stage_ |= stage;
+  return true;
+}
+MoveGenerator::Iterator MoveGenerator::begin() { return Iterator(*this, 0); }
+MoveGenerator::Iterator MoveGenerator::end() { return Iterator(*this, -1); }
+
+MoveGenerator::Iterator::Iterator(MoveGenerator& generator, int index)
+    : generator_(generator), index_(index) {}
+const Move& MoveGenerator::Iterator::operator*() const {
+  return generator_.moves_->begin()[index_];
+}
+MoveGenerator::Iterator& MoveGenerator::Iterator::operator++() {
+  index_++;
+  return *this;
+}
+bool MoveGenerator::Iterator::operator!=(const Iterator& other) const {
+  bool end = isEnd();
+  if (end != other.isEnd()) {
+    return true;
+  }
+  return !end && (&generator_ != &other.generator_ || index_ != other.index_);
+}
+bool MoveGenerator::Iterator::isEnd() const {
+  if (index_ < 0) {
+    return true;
+  }
+  while (index_ >= generator_.moves_->size()) {
+    if (!generator_.generate()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace moderato
@@ -0,0 +1,61 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024-2025 Ivan Denkovski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "MoveOrdering.h"
+#include "Position.h"
+
+namespace moderato {
+
+class MoveGenerator {
+  Position* position_;
+  MoveList* moves_;
+  int stage_;
+  MoveOrdering* moveOrdering_;
+  bool defence_;
+  bool checks_;
+  bool generate();
+
+ public:
+  class Iterator {
+    MoveGenerator& generator_;
+    int index_;
+    bool isEnd() const;
+
+   public:
+    Iterator(MoveGenerator& generator, int index);
+    const Move& operator*() const;
+    Iterator& operator++();
+    bool operator!=(const Iterator& other) const;
+  };
+  MoveGenerator(Position& position, MoveOrdering* moveOrdering, bool defence,
+                bool checks);
+  MoveGenerator(Position& position, bool checks);
+  explicit MoveGenerator(MoveList& moves);
+  Iterator begin();
+  Iterator end();
+};
+
+}  // namespace moderato
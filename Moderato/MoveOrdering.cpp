@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Ivan Denkovski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "MoveOrdering.h"
+
+#include <algorithm>
+
+#include "CheckInfo.h"
+
+namespace moderato {
+
+MoveOrdering::MoveOrdering() : refutations_(), killers_(), history_() {}
+int MoveOrdering::evaluate(Position& position, const Move& move,
+                           bool defence, const CheckInfo* checkInfo) {
+  int ply = position.getPly();
+  if (defence) {
+    const std::array<Move, 4>& refutations = refutations_[ply];
+    for (int index = 0; index < 4; index++) {
+      if (move == refutations[index]) {
+        return (7 - index) << 28;
+      }
+    }
+  }
+  if (move == killers_[ply][0]) {
+    return 3 << 28;
+  }
+  if (move == killers_[ply][1]) {
+    return 2 << 28;
+  }
+  bool black = position.isBlackToMove();
+  int key = history_[black][move.getOrigin()][move.getTarget()] * 2;
+  if (defence) {
+    if (move.getOrigin() == position.getBoard().getRoyal(black)) {
+      key++;
+    }
+  } else if (checkInfo && checkInfo->mayGiveCheck(move)) {
+    key += 1 << 28;
+  }
+  return key;
+}
+void MoveOrdering::sort(Position& position, Move* first, Move* last,
+                        bool defence) {
+  if (defence) {
+    sort(position, first, last, true, nullptr);
+  } else {
+    CheckInfo checkInfo(position.getBoard(), position.isBlackToMove(),
+                        position.getMoveFactory());
+    sort(position, first, last, false, &checkInfo);
+  }
+}
+void MoveOrdering::sort(Position& position, Move* first, Move* last,
+                        bool defence, const CheckInfo* checkInfo) {
+  int size = static_cast<int>(last - first);
+  for (int index = 0; index < size; index++) {
+    std::pair<int, Move> key = {
+        evaluate(position, first[index], defence, checkInfo), first[index]};
+    int hole = index;
+    for (; hole > 0 && keys_[hole - 1].first < key.first; hole--) {
+      keys_[hole] = keys_[hole - 1];
+    }
+    keys_[hole] = key;
+  }
+  for (int index = 0; index < size; index++) {
+    first[index] = keys_[index].second;
+  }
+}
+void MoveOrdering::update(Position& position, const Move& move, int depth) {
+  std::array<Move, 2>& killers = killers_[position.getPly()];
+  if (!(move == killers[0])) {
+    killers[1] = killers[0];
+    killers[0] = move;
+  }
+  int& history =
+      history_[position.isBlackToMove()][move.getOrigin()][move.getTarget()];
+  history = std::min(history + depth * depth, (1 << 27) - 1);
+}
+void MoveOrdering::refute(Position& position, const Move& move) {
+  std::array<Move, 4>& refutations = refutations_[position.getPly()];
+  int index = 0;
+  while (index < 3 && !(move == refutations[index])) {
+    index++;
+  }
+  for (; index > 0; index--) {
+    refutations[index] = refutations[index - 1];
+  }
+  refutations[0] = move;
+}
+
+}  // namespace moderato
@@ -0,0 +1,52 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Ivan Denkovski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+
+#include "Position.h"
+
+namespace moderato {
+
+class CheckInfo;
+
+class MoveOrdering {
+  std::array<std::array<Move, 4>, Position::MAX_PLY + 1> refutations_;
+  std::array<std::array<Move, 2>, Position::MAX_PLY + 1> killers_;
+  std::array<std::array<std::array<int, 128>, 128>, 2> history_;
+  std::array<std::pair<int, Move>, 1024> keys_;
+  int evaluate(Position& position, const Move& move, bool defence,
+               const CheckInfo* checkInfo);
+  void sort(Position& position, Move* first, Move* last, bool defence,
+            const CheckInfo* checkInfo);
+
+ public:
+  MoveOrdering();
+  void sort(Position& position, Move* first, Move* last, bool defence);
+  void update(Position& position, const Move& move, int depth);
+  void refute(Position& position, const Move& move);
+};
+
+}  // namespace moderato
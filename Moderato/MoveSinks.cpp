@@ -0,0 +1,80 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Ivan Denkovski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "MoveSinks.h"
+
+#include "Position.h"
+
+namespace moderato {
+
+MoveCollector::MoveCollector(MoveList& moves) : moves_(moves) {}
+MoveList& MoveCollector::getMoves() { return moves_; }
+bool MoveCollector::flush() { return true; }
+
+LegalMoveCounter::LegalMoveCounter(Position& position, int royal, bool check,
+                                   const std::array<bool, 128>& lines,
+                                   int limit)
+    : position_(position),
+      royal_(royal),
+      check_(check),
+      lines_(lines),
+      limit_(limit),
+      nLegalMoves_(0),
+      deferredMoves_(nullptr) {}
+MoveList& LegalMoveCounter::getMoves() { return moves_; }
+bool LegalMoveCounter::flush() {
+  bool result = true;
+  for (const Move& move : moves_) {
+    if (!count(move)) {
+      result = false;
+      break;
+    }
+  }
+  moves_.clear();
+  return result;
+}
+bool LegalMoveCounter::count(const Move& move) {
+  if (royal_ < 0) {
+    nLegalMoves_++;
+  } else if (position_.isLocal(move, royal_, lines_)) {
+    if (!check_) {
+      nLegalMoves_++;
+    }
+  } else if (deferredMoves_) {
+    deferredMoves_->add(move);
+  } else {
+    bool legal = move.make(position_);
+    move.unmake(position_);
+    if (legal) {
+      nLegalMoves_++;
+    }
+  }
+  return nLegalMoves_ < limit_;
+}
+void LegalMoveCounter::defer(MoveList* deferredMoves) {
+  deferredMoves_ = deferredMoves;
+}
+int LegalMoveCounter::getCount() const { return nLegalMoves_; }
+
+}  // namespace moderato
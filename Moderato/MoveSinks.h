@@ -0,0 +1,62 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Ivan Denkovski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+
+#include "Move.h"
+
+namespace moderato {
+
+class MoveCollector {
+  MoveList& moves_;
+
+ public:
+  MoveCollector(MoveList& moves);
+  MoveList& getMoves();
+  bool flush();
+};
+
+class LegalMoveCounter {
+  Position& position_;
+  int royal_;
+  bool check_;
+  const std::array<bool, 128>& lines_;
+  int limit_;
+  int nLegalMoves_;
+  MoveList* deferredMoves_;
+  MoveList moves_;
+
+ public:
+  LegalMoveCounter(Position& position, int royal, bool check,
+                   const std::array<bool, 128>& lines, int limit);
+  MoveList& getMoves();
+  bool flush();
+  bool count(const Move& move);
+  void defer(MoveList* deferredMoves);
+  int getCount() const;
+};
+
+}  // namespace moderato
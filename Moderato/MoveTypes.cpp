@@ -29,244 +29,242 @@
 namespace moderato {
 
 QuietMove::QuietMove(int origin, int target)
-    : origin_(origin), target_(target) {}
-void QuietMove::write(std::ostream& output) const {
-  output << "QuietMove[origin=" << origin_ << ", target=" << target_ << "]";
-}
-void QuietMove::updatePieces(Position& position) const {
-  updatePieces(position.getBoard());
-}
-void QuietMove::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board) const {
-  board.at(target_) = std::move(board.at(origin_));
-}
-void QuietMove::revertPieces(Position& position) const {
-  revertPieces(position.getBoard());
-}
-void QuietMove::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board) const {
-  board.at(origin_) = std::move(board.at(target_));
-}
-void QuietMove::updateCastlings(std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  castlings.erase(target_);
-}
-void QuietMove::preWrite(Position& position, std::ostream& lanBuilder,
-                         int translate) const {
-  preWrite(position.getBoard(), lanBuilder, translate);
-}
-void QuietMove::preWrite(const std::array<std::unique_ptr<Piece>, 128>& board,
-                         std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "-" << toCode(board, target_);
-}
+    : Move(QUIET_MOVE, origin, target, 0, 0, false, false) {}
 
-Capture::Capture(int origin, int target) : QuietMove(origin, target) {}
-void Capture::write(std::ostream& output) const {
-  output << "Capture[origin=" << origin_ << ", target=" << target_ << "]";
-}
-void Capture::updatePieces(Position& position) const {
-  updatePieces(position.getBoard(), position.getTable());
-}
-void Capture::updatePieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                           std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(target_)));
-  board.at(target_) = std::move(board.at(origin_));
-}
-void Capture::revertPieces(Position& position) const {
-  revertPieces(position.getBoard(), position.getTable());
-}
-void Capture::revertPieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                           std::stack<std::unique_ptr<Piece>>& table) const {
-  board.at(origin_) = std::move(board.at(target_));
-  board.at(target_) = std::move(table.top());
-  table.pop();
-}
-void Capture::preWrite(const std::array<std::unique_ptr<Piece>, 128>& board,
-                       std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_);
-}
+Capture::Capture(int origin, int target)
+    : Move(CAPTURE, origin, target, 0, 0, false, false) {}
 
-Castling::Castling(int origin, int target, int origin2, int target2)
-    : QuietMove(origin, target), origin2_(origin2), target2_(target2) {}
-bool Castling::preMake(Position& position) const {
-  NullMove nullMove;
-  bool result = nullMove.make(position);
-  nullMove.unmake(position);
-  QuietMove stopMove(origin_, target2_);
-  result = stopMove.make(position) && result;
-  stopMove.unmake(position);
-  return result;
-}
-void Castling::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board) const {
-  board.at(target_) = std::move(board.at(origin_));
-  board.at(target2_) = std::move(board.at(origin2_));
-}
-void Castling::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board) const {
-  board.at(origin2_) = std::move(board.at(target2_));
-  board.at(origin_) = std::move(board.at(target_));
-}
-void Castling::updateCastlings(std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  castlings.erase(target_);
-  castlings.erase(origin2_);
-  castlings.erase(target2_);
-}
+LongCastling::LongCastling(int origin, int target, int origin2)
+    : Move(LONG_CASTLING, origin, target, origin2, 0, false, false) {}
 
-LongCastling::LongCastling(int origin, int target, int origin2, int target2)
-    : Castling(origin, target, origin2, target2) {}
-void LongCastling::write(std::ostream& output) const {
-  output << "LongCastling[origin=" << origin_ << ", target=" << target_
-         << ", origin2=" << origin2_ << ", target2=" << target2_ << "]";
-}
-void LongCastling::preWrite(Position& position, std::ostream& lanBuilder,
-                            int translate) const {
-  lanBuilder << "0-0-0";
-}
+ShortCastling::ShortCastling(int origin, int target, int origin2)
+    : Move(SHORT_CASTLING, origin, target, origin2, 0, false, false) {}
 
-ShortCastling::ShortCastling(int origin, int target, int origin2, int target2)
-    : Castling(origin, target, origin2, target2) {}
-void ShortCastling::write(std::ostream& output) const {
-  output << "ShortCastling[origin=" << origin_ << ", target=" << target_
-         << ", origin2=" << origin2_ << ", target2=" << target2_ << "]";
-}
-void ShortCastling::preWrite(Position& position, std::ostream& lanBuilder,
-                             int translate) const {
-  lanBuilder << "0-0";
-}
+DoubleStep::DoubleStep(int origin, int target)
+    : Move(DOUBLE_STEP, origin, target, 0, 0, false, false) {}
 
-DoubleStep::DoubleStep(int origin, int target, int stop)
-    : QuietMove(origin, target), stop_(stop) {}
-void DoubleStep::write(std::ostream& output) const {
-  output << "DoubleStep[origin=" << origin_ << ", target=" << target_
-         << ", stop=" << stop_ << "]";
-}
-void DoubleStep::updateCastlings(std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  castlings.erase(target_);
-  castlings.erase(stop_);
-}
-void DoubleStep::updateEnPassant(std::shared_ptr<int>& enPassant) const {
-  enPassant = std::make_shared<int>(stop_);
-}
+EnPassant::EnPassant(int origin, int target)
+    : Move(EN_PASSANT, origin, target, 0, 0, false, false) {}
 
-EnPassant::EnPassant(int origin, int target, int stop)
-    : Capture(origin, target), stop_(stop) {}
-void EnPassant::write(std::ostream& output) const {
-  output << "EnPassant[origin=" << origin_ << ", target=" << target_
-         << ", stop=" << stop_ << "]";
-}
-void EnPassant::updatePieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                             std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(stop_)));
-  board.at(target_) = std::move(board.at(origin_));
-}
-void EnPassant::revertPieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                             std::stack<std::unique_ptr<Piece>>& table) const {
-  board.at(origin_) = std::move(board.at(target_));
-  board.at(stop_) = std::move(table.top());
-  table.pop();
-}
-void EnPassant::updateCastlings(std::set<int>& castlings) const {
-  castlings.erase(origin_);
-  castlings.erase(target_);
-  castlings.erase(stop_);
-}
-void EnPassant::preWrite(const std::array<std::unique_ptr<Piece>, 128>& board,
-                         std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_) << " e.p.";
-}
+Promotion::Promotion(int origin, int target, int type)
+    : Move(PROMOTION, origin, target, 0, type, false, false) {}
 
-Promotion::Promotion(int origin, int target, bool black, int order)
-    : QuietMove(origin, target), black_(black), order_(order) {}
-void Promotion::write(std::ostream& output) const {
-  output << "Promotion[origin=" << origin_ << ", target=" << target_
-         << ", black=" << black_ << ", order=" << order_ << "]";
-}
-void Promotion::updatePieces(Position& position) const {
-  updatePieces(position.getBoard(), position.getBox());
-}
-void Promotion::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box)
-    const {
-  box.at(black_).at(order_).push_back(std::move(board.at(origin_)));
-  board.at(target_) = std::move(box.at(black_).at(order_).front());
-  box.at(black_).at(order_).pop_front();
-}
-void Promotion::revertPieces(Position& position) const {
-  revertPieces(position.getBoard(), position.getBox());
-}
-void Promotion::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box)
-    const {
-  box.at(black_).at(order_).push_front(std::move(board.at(target_)));
-  board.at(origin_) = std::move(box.at(black_).at(order_).back());
-  box.at(black_).at(order_).pop_back();
-}
-void Promotion::preWrite(Position& position, std::ostream& lanBuilder,
-                         int translate) const {
-  preWrite(position.getBoard(), position.getBox(), lanBuilder, translate);
-}
-void Promotion::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "-" << toCode(board, target_) << "="
-             << box.at(black_).at(order_).front()->getCode(translate);
-}
+PromotionCapture::PromotionCapture(int origin, int target, int type)
+    : Move(PROMOTION_CAPTURE, origin, target, 0, type, false, false) {}
 
-PromotionCapture::PromotionCapture(int origin, int target, bool black,
-                                   int order)
-    : Promotion(origin, target, black, order) {}
-void PromotionCapture::write(std::ostream& output) const {
-  output << "PromotionCapture[origin=" << origin_ << ", target=" << target_
-         << ", black=" << black_ << ", order=" << order_ << "]";
-}
-void PromotionCapture::updatePieces(Position& position) const {
-  updatePieces(position.getBoard(), position.getBox(), position.getTable());
-}
-void PromotionCapture::updatePieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  table.push(std::move(board.at(target_)));
-  box.at(black_).at(order_).push_back(std::move(board.at(origin_)));
-  board.at(target_) = std::move(box.at(black_).at(order_).front());
-  box.at(black_).at(order_).pop_front();
-}
-void PromotionCapture::revertPieces(Position& position) const {
-  revertPieces(position.getBoard(), position.getBox(), position.getTable());
-}
-void PromotionCapture::revertPieces(
-    std::array<std::unique_ptr<Piece>, 128>& board,
-    std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-    std::stack<std::unique_ptr<Piece>>& table) const {
-  box.at(black_).at(order_).push_front(std::move(board.at(target_)));
-  board.at(origin_) = std::move(box.at(black_).at(order_).back());
-  box.at(black_).at(order_).pop_back();
-  board.at(target_) = std::move(table.top());
-  table.pop();
-}
-void PromotionCapture::preWrite(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    std::ostream& lanBuilder, int translate) const {
-  lanBuilder << board.at(origin_)->getCode(translate) << toCode(board, origin_)
-             << "x" << toCode(board, target_) << "="
-             << box.at(black_).at(order_).front()->getCode(translate);
+void Move::write(std::ostream& output) const {
+  switch (getKind()) {
+    case NULL_MOVE:
+      output << "NullMove[]";
+      break;
+    case QUIET_MOVE:
+      output << "QuietMove[origin=" << getOrigin()
+             << ", target=" << getTarget() << "]";
+      break;
+    case CAPTURE:
+      output << "Capture[origin=" << getOrigin() << ", target=" << getTarget()
+             << "]";
+      break;
+    case LONG_CASTLING:
+      output << "LongCastling[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", origin2=" << getSquare2()
+             << ", target2=" << getTarget2() << "]";
+      break;
+    case SHORT_CASTLING:
+      output << "ShortCastling[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", origin2=" << getSquare2()
+             << ", target2=" << getTarget2() << "]";
+      break;
+    case DOUBLE_STEP:
+      output << "DoubleStep[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", stop=" << getStop() << "]";
+      break;
+    case EN_PASSANT:
+      output << "EnPassant[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", stop=" << getStop() << "]";
+      break;
+    case PROMOTION:
+      output << "Promotion[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", black=" << isBlack()
+             << ", type=" << getType() << "]";
+      break;
+    case PROMOTION_CAPTURE:
+      output << "PromotionCapture[origin=" << getOrigin()
+             << ", target=" << getTarget() << ", black=" << isBlack()
+             << ", type=" << getType() << "]";
+      break;
+    default:
+      writeFairy(output);
+  }
+}
+bool Move::preMake(Position& position) const {
+  switch (getKind()) {
+    case LONG_CASTLING:
+    case SHORT_CASTLING: {
+      Board& board = position.getBoard();
+      bool black = position.isBlackToMove();
+      if (position.isCheck()) {
+        return false;
+      }
+      board.move(getOrigin(), getTarget2());
+      bool result = !position.isAttacked(getTarget2(), !black);
+      board.move(getTarget2(), getOrigin());
+      return result;
+    }
+    default:
+      return true;
+  }
+}
+void Move::updatePieces(Board& board, std::array<int, 20>& box,
+                        unsigned char& table) const {
+  switch (getKind()) {
+    case NULL_MOVE:
+      break;
+    case QUIET_MOVE:
+    case DOUBLE_STEP:
+      board.move(getOrigin(), getTarget());
+      break;
+    case CAPTURE:
+      table = board.remove(getTarget());
+      board.move(getOrigin(), getTarget());
+      break;
+    case LONG_CASTLING:
+    case SHORT_CASTLING:
+      board.move(getOrigin(), getTarget());
+      board.move(getSquare2(), getTarget2());
+      break;
+    case EN_PASSANT:
+      table = board.remove(getStop());
+      board.move(getOrigin(), getTarget());
+      break;
+    case PROMOTION:
+      board.remove(getOrigin());
+      board.place(getTarget(), Board::toCode(getType(), isBlack()));
+      box[Board::toCode(getType(), isBlack())]--;
+      break;
+    case PROMOTION_CAPTURE:
+      table = board.remove(getTarget());
+      board.remove(getOrigin());
+      board.place(getTarget(), Board::toCode(getType(), isBlack()));
+      box[Board::toCode(getType(), isBlack())]--;
+      break;
+    default:
+      updateFairyPieces(board, box, table);
+  }
+}
+void Move::revertPieces(Board& board, std::array<int, 20>& box,
+                        unsigned char& table) const {
+  switch (getKind()) {
+    case NULL_MOVE:
+      break;
+    case QUIET_MOVE:
+    case DOUBLE_STEP:
+      board.move(getTarget(), getOrigin());
+      break;
+    case CAPTURE:
+      board.move(getTarget(), getOrigin());
+      board.place(getTarget(), table);
+      break;
+    case LONG_CASTLING:
+    case SHORT_CASTLING:
+      board.move(getTarget2(), getSquare2());
+      board.move(getTarget(), getOrigin());
+      break;
+    case EN_PASSANT:
+      board.move(getTarget(), getOrigin());
+      board.place(getStop(), table);
+      break;
+    case PROMOTION:
+      box[Board::toCode(getType(), isBlack())]++;
+      board.remove(getTarget());
+      board.place(getOrigin(), Board::toCode(Board::PAWN, isBlack()));
+      break;
+    case PROMOTION_CAPTURE:
+      box[Board::toCode(getType(), isBlack())]++;
+      board.remove(getTarget());
+      board.place(getOrigin(), Board::toCode(Board::PAWN, isBlack()));
+      board.place(getTarget(), table);
+      break;
+    default:
+      revertFairyPieces(board, box, table);
+  }
+}
+void Move::updateCastlings(int& castlings) const {
+  switch (getKind()) {
+    case NULL_MOVE:
+      break;
+    case QUIET_MOVE:
+    case CAPTURE:
+    case PROMOTION:
+    case PROMOTION_CAPTURE:
+      castlings &= ~Board::toCastling(getOrigin());
+      castlings &= ~Board::toCastling(getTarget());
+      break;
+    case LONG_CASTLING:
+    case SHORT_CASTLING:
+      castlings &= ~Board::toCastling(getOrigin());
+      castlings &= ~Board::toCastling(getTarget());
+      castlings &= ~Board::toCastling(getSquare2());
+      castlings &= ~Board::toCastling(getTarget2());
+      break;
+    case DOUBLE_STEP:
+    case EN_PASSANT:
+      castlings &= ~Board::toCastling(getOrigin());
+      castlings &= ~Board::toCastling(getTarget());
+      castlings &= ~Board::toCastling(getStop());
+      break;
+    default:
+      updateFairyCastlings(castlings);
+  }
+}
+void Move::preWrite(const Board& board, std::ostream& lanBuilder,
+                    int translate) const {
+  switch (getKind()) {
+    case NULL_MOVE:
+      lanBuilder << "null";
+      break;
+    case QUIET_MOVE:
+    case DOUBLE_STEP:
+      lanBuilder << board.getPiece(getOrigin()).getCode(translate)
+                 << toCode(board, getOrigin()) << "-"
+                 << toCode(board, getTarget());
+      break;
+    case CAPTURE:
+      lanBuilder << board.getPiece(getOrigin()).getCode(translate)
+                 << toCode(board, getOrigin()) << "x"
+                 << toCode(board, getTarget());
+      break;
+    case LONG_CASTLING:
+      lanBuilder << "0-0-0";
+      break;
+    case SHORT_CASTLING:
+      lanBuilder << "0-0";
+      break;
+    case EN_PASSANT:
+      lanBuilder << board.getPiece(getOrigin()).getCode(translate)
+                 << toCode(board, getOrigin()) << "x"
+                 << toCode(board, getTarget()) << " e.p.";
+      break;
+    case PROMOTION:
+      lanBuilder << board.getPiece(getOrigin()).getCode(translate)
+                 << toCode(board, getOrigin()) << "-"
+                 << toCode(board, getTarget()) << "="
+                 << Board::toPiece(Board::toCode(getType(), isBlack()))
+                        .getCode(translate);
+      break;
+    case PROMOTION_CAPTURE:
+      lanBuilder << board.getPiece(getOrigin()).getCode(translate)
+                 << toCode(board, getOrigin()) << "x"
+                 << toCode(board, getTarget()) << "="
+                 << Board::toPiece(Board::toCode(getType(), isBlack()))
+                        .getCode(translate);
+      break;
+    default:
+      preWriteFairy(board, lanBuilder, translate);
+  }
 }
 
-std::string toCode(const std::array<std::unique_ptr<Piece>, 128>& board,
-                   int square) {
+std::string toCode(const Board& board, int square) {
   return std::string()
       .append(1, 'a' + square / 16)
       .append(1, '1' + square % 16);
@@ -24,160 +24,53 @@
 
 #pragma once
 
+#include <string>
+
+#include "Board.h"
 #include "Move.h"
-#include "Piece.h"
 
 namespace moderato {
 
-class QuietMove : public NullMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(Position& position) const override;
-  virtual void updatePieces(
-      std::array<std::unique_ptr<Piece>, 128>& board) const;
-  void revertPieces(Position& position) const override;
-  virtual void revertPieces(
-      std::array<std::unique_ptr<Piece>, 128>& board) const;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(Position& position, std::ostream& lanBuilder,
-                int translate) const override;
-  virtual void preWrite(const std::array<std::unique_ptr<Piece>, 128>& board,
-                        std::ostream& lanBuilder, int translate) const;
-
- protected:
-  const int origin_;
-  const int target_;
-
+class QuietMove : public Move {
  public:
   QuietMove(int origin, int target);
 };
 
-class Capture : public QuietMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(Position& position) const override;
-  virtual void updatePieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                            std::stack<std::unique_ptr<Piece>>& table) const;
-  void revertPieces(Position& position) const override;
-  virtual void revertPieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                            std::stack<std::unique_ptr<Piece>>& table) const;
-  void preWrite(const std::array<std::unique_ptr<Piece>, 128>& board,
-                std::ostream& lanBuilder, int translate) const override;
-
+class Capture : public Move {
  public:
   Capture(int origin, int target);
 };
 
-class Castling : public QuietMove {
-  bool preMake(Position& position) const override;
-  void updatePieces(
-      std::array<std::unique_ptr<Piece>, 128>& board) const override;
-  void revertPieces(
-      std::array<std::unique_ptr<Piece>, 128>& board) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-
- protected:
-  const int origin2_;
-  const int target2_;
-  Castling(int origin, int target, int origin2, int target2);
-};
-
-class LongCastling : public Castling {
-  void write(std::ostream& output) const override;
-  void preWrite(Position& position, std::ostream& lanBuilder,
-                int translate) const override;
-
+class LongCastling : public Move {
  public:
-  LongCastling(int origin, int target, int origin2, int target2);
+  LongCastling(int origin, int target, int origin2);
 };
 
-class ShortCastling : public Castling {
-  void write(std::ostream& output) const override;
-  void preWrite(Position& position, std::ostream& lanBuilder,
-                int translate) const override;
-
+class ShortCastling : public Move {
  public:
-  ShortCastling(int origin, int target, int origin2, int target2);
+  ShortCastling(int origin, int target, int origin2);
 };
 
-class DoubleStep : public QuietMove {
-  void write(std::ostream& output) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void updateEnPassant(std::shared_ptr<int>& enPassant) const override;
-
- protected:
-  const int stop_;
-
+class DoubleStep : public Move {
  public:
-  DoubleStep(int origin, int target, int stop);
+  DoubleStep(int origin, int target);
 };
 
-class EnPassant : public Capture {
-  void write(std::ostream& output) const override;
-  void updatePieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void revertPieces(std::array<std::unique_ptr<Piece>, 128>& board,
-                    std::stack<std::unique_ptr<Piece>>& table) const override;
-  void updateCastlings(std::set<int>& castlings) const override;
-  void preWrite(const std::array<std::unique_ptr<Piece>, 128>& board,
-                std::ostream& lanBuilder, int translate) const override;
-
- protected:
-  const int stop_;
-
+class EnPassant : public Move {
  public:
-  EnPassant(int origin, int target, int stop);
+  EnPassant(int origin, int target);
 };
 
-class Promotion : public QuietMove {
-  void write(std::ostream& output) const override;
-  void updatePieces(Position& position) const override;
-  virtual void updatePieces(
-      std::array<std::unique_ptr<Piece>, 128>& board,
-      std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box)
-      const;
-  void revertPieces(Position& position) const override;
-  virtual void revertPieces(
-      std::array<std::unique_ptr<Piece>, 128>& board,
-      std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box)
-      const;
-  void preWrite(Position& position, std::ostream& lanBuilder,
-                int translate) const override;
-  virtual void preWrite(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      std::ostream& lanBuilder, int translate) const;
-
- protected:
-  const bool black_;
-  const int order_;
-
+class Promotion : public Move {
  public:
-  Promotion(int origin, int target, bool black, int order);
+  Promotion(int origin, int target, int type);
 };
 
-class PromotionCapture : public Promotion {
-  void write(std::ostream& output) const override;
-  void updatePieces(Position& position) const override;
-  virtual void updatePieces(
-      std::array<std::unique_ptr<Piece>, 128>& board,
-      std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-      std::stack<std::unique_ptr<Piece>>& table) const;
-  void revertPieces(Position& position) const override;
-  virtual void revertPieces(
-      std::array<std::unique_ptr<Piece>, 128>& board,
-      std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& box,
-      std::stack<std::unique_ptr<Piece>>& table) const;
-  void preWrite(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      std::ostream& lanBuilder, int translate) const override;
-
+class PromotionCapture : public Move {
  public:
-  PromotionCapture(int origin, int target, bool black, int order);
+  PromotionCapture(int origin, int target, int type);
 };
 
-std::string toCode(const std::array<std::unique_ptr<Piece>, 128>& board,
-                   int square);
+std::string toCode(const Board& board, int square);
 
 }  // namespace moderato
@@ -46,319 +46,162 @@ bool King::isRoyal() const { return true; }
 bool King::isCastling() const { return true; }
 bool Rook::isCastling() const { return true; }
 
-int King::findRebirthSquare(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int square,
-    bool opposite) const {
+int King::findRebirthSquare(const Board& board, int square,
+                            bool opposite) const {
   return black_ != opposite ? 71 : 64;
 }
-int Queen::findRebirthSquare(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int square,
-    bool opposite) const {
+int Queen::findRebirthSquare(const Board& board, int square,
+                             bool opposite) const {
   return black_ != opposite ? 55 : 48;
 }
-int Rook::findRebirthSquare(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int square,
-    bool opposite) const {
+int Rook::findRebirthSquare(const Board& board, int square,
+                            bool opposite) const {
   return (square / 16 + square % 16) % 2 ? (black_ != opposite ? 7 : 112)
                                          : (black_ != opposite ? 119 : 0);
 }
-int Bishop::findRebirthSquare(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int square,
-    bool opposite) const {
+int Bishop::findRebirthSquare(const Board& board, int square,
+                              bool opposite) const {
   return (square / 16 + square % 16) % 2 ? (black_ != opposite ? 39 : 80)
                                          : (black_ != opposite ? 87 : 32);
 }
-int Knight::findRebirthSquare(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int square,
-    bool opposite) const {
+int Knight::findRebirthSquare(const Board& board, int square,
+                              bool opposite) const {
   return (square / 16 + square % 16) % 2 ? (black_ != opposite ? 103 : 16)
                                          : (black_ != opposite ? 23 : 96);
 }
-int Pawn::findRebirthSquare(
-    const std::array<std::unique_ptr<Piece>, 128>& board, int square,
-    bool opposite) const {
+int Pawn::findRebirthSquare(const Board& board, int square,
+                            bool opposite) const {
   return (square / 16) * 16 + (black_ != opposite ? 6 : 1);
 }
 
-std::vector<int>& King::leaps(
-    const std::array<std::unique_ptr<Piece>, 128>& board) {
+std::vector<int>& King::leaps(const Board& board) {
   static std::vector<int> leaps = {-17, -16, -15, -1, 1, 15, 16, 17};
   return leaps;
 }
-const std::vector<int>& King::getLeaps(
-    const std::array<std::unique_ptr<Piece>, 128>& board) const {
+const std::vector<int>& King::getLeaps(const Board& board) const {
   return leaps(board);
 }
-bool King::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  if (!Leaper::generateMoves(board, origin, moveFactory, moves)) {
+bool King::generateMoves(const Board& board, const std::array<int, 20>& box,
+                         const std::pair<int, int>& state, int origin,
+                         const MoveFactory& moveFactory, MoveList& moves,
+                         int stage) const {
+  if (!Leaper::generateMoves(board, origin, moveFactory, moves, stage)) {
     return false;
   }
-  const std::set<int>& castlings = state.first;
-  if (origin == (black_ ? 71 : 64) && castlings.count(origin)) {
-    for (int direction : {-16, 16}) {
-      int distance = 1;
-      while (true) {
-        int origin2 = origin + distance * direction;
-        if (!(origin2 & 136)) {
-          if (castlings.count(origin2)) {
-            int target = origin + 2 * direction;
-            int target2 = origin + direction;
-            if (direction > 0) {
-              moveFactory.generateShortCastling(board, origin, target, origin2,
-                                                target2, moves);
-            } else {
-              moveFactory.generateLongCastling(board, origin, target, origin2,
-                                               target2, moves);
-            }
-            break;
-          } else if (board.at(origin2)) {
-            break;
-          } else {
-            distance++;
-          }
-        } else {
-          break;
-        }
-      }
-    }
+  int castlings = state.first;
+  if (stage & QUIET_MOVES && origin == (black_ ? 71 : 64) &&
+      castlings & Board::toCastling(origin)) {
+    moveFactory.generateCastlings(board, castlings, origin, moves);
   }
   return true;
 }
-bool King::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory) const {
-  return Leaper::generateMoves(board, origin, moveFactory);
+bool King::generateMoves(const Board& board, const std::array<int, 20>& box,
+                         const std::pair<int, int>& state, int origin,
+                         const MoveFactory& moveFactory,
+                         LegalMoveCounter& counter) const {
+  if (!Leaper::generateMoves(board, origin, moveFactory, counter)) {
+    return false;
+  }
+  int castlings = state.first;
+  if (origin == (black_ ? 71 : 64) && castlings & Board::toCastling(origin)) {
+    return moveFactory.generateCastlings(board, castlings, origin, counter);
+  }
+  return true;
 }
 
-std::vector<int>& Queen::rides(
-    const std::array<std::unique_ptr<Piece>, 128>& board) {
+std::vector<int>& Queen::rides(const Board& board) {
   static std::vector<int> rides = {-17, -16, -15, -1, 1, 15, 16, 17};
   return rides;
 }
-const std::vector<int>& Queen::getRides(
-    const std::array<std::unique_ptr<Piece>, 128>& board) const {
+const std::vector<int>& Queen::getRides(const Board& board) const {
   return rides(board);
 }
-bool Queen::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  return Rider::generateMoves(board, origin, moveFactory, moves);
-}
-bool Queen::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory) const {
-  return Rider::generateMoves(board, origin, moveFactory);
+bool Queen::generateMoves(const Board& board, const std::array<int, 20>& box,
+                          const std::pair<int, int>& state, int origin,
+                          const MoveFactory& moveFactory, MoveList& moves,
+                          int stage) const {
+  return Rider::generateMoves(board, origin, moveFactory, moves, stage);
+}
+bool Queen::generateMoves(const Board& board, const std::array<int, 20>& box,
+                          const std::pair<int, int>& state, int origin,
+                          const MoveFactory& moveFactory,
+                          LegalMoveCounter& counter) const {
+  return Rider::generateMoves(board, origin, moveFactory, counter);
 }
 
-std::vector<int>& Rook::rides(
-    const std::array<std::unique_ptr<Piece>, 128>& board) {
+std::vector<int>& Rook::rides(const Board& board) {
   static std::vector<int> rides = {-16, -1, 1, 16};
   return rides;
 }
-const std::vector<int>& Rook::getRides(
-    const std::array<std::unique_ptr<Piece>, 128>& board) const {
+const std::vector<int>& Rook::getRides(const Board& board) const {
   return rides(board);
 }
-bool Rook::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  return Rider::generateMoves(board, origin, moveFactory, moves);
-}
-bool Rook::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory) const {
-  return Rider::generateMoves(board, origin, moveFactory);
+bool Rook::generateMoves(const Board& board, const std::array<int, 20>& box,
+                         const std::pair<int, int>& state, int origin,
+                         const MoveFactory& moveFactory, MoveList& moves,
+                         int stage) const {
+  return Rider::generateMoves(board, origin, moveFactory, moves, stage);
+}
+bool Rook::generateMoves(const Board& board, const std::array<int, 20>& box,
+                         const std::pair<int, int>& state, int origin,
+                         const MoveFactory& moveFactory,
+                         LegalMoveCounter& counter) const {
+  return Rider::generateMoves(board, origin, moveFactory, counter);
 }
 
-std::vector<int>& Bishop::rides(
-    const std::array<std::unique_ptr<Piece>, 128>& board) {
+std::vector<int>& Bishop::rides(const Board& board) {
   static std::vector<int> rides = {-17, -15, 15, 17};
   return rides;
 }
-const std::vector<int>& Bishop::getRides(
-    const std::array<std::unique_ptr<Piece>, 128>& board) const {
+const std::vector<int>& Bishop::getRides(const Board& board) const {
   return rides(board);
 }
-bool Bishop::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  return Rider::generateMoves(board, origin, moveFactory, moves);
-}
-bool Bishop::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory) const {
-  return Rider::generateMoves(board, origin, moveFactory);
+bool Bishop::generateMoves(const Board& board, const std::array<int, 20>& box,
+                           const std::pair<int, int>& state, int origin,
+                           const MoveFactory& moveFactory, MoveList& moves,
+                           int stage) const {
+  return Rider::generateMoves(board, origin, moveFactory, moves, stage);
+}
+bool Bishop::generateMoves(const Board& board, const std::array<int, 20>& box,
+                           const std::pair<int, int>& state, int origin,
+                           const MoveFactory& moveFactory,
+                           LegalMoveCounter& counter) const {
+  return Rider::generateMoves(board, origin, moveFactory, counter);
 }
 
-std::vector<int>& Knight::leaps(
-    const std::array<std::unique_ptr<Piece>, 128>& board) {
+std::vector<int>& Knight::leaps(const Board& board) {
   static std::vector<int> leaps = {-33, -31, -18, -14, 14, 18, 31, 33};
   return leaps;
 }
-const std::vector<int>& Knight::getLeaps(
-    const std::array<std::unique_ptr<Piece>, 128>& board) const {
+const std::vector<int>& Knight::getLeaps(const Board& board) const {
   return leaps(board);
 }
-bool Knight::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  return Leaper::generateMoves(board, origin, moveFactory, moves);
-}
-bool Knight::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory) const {
-  return Leaper::generateMoves(board, origin, moveFactory);
+bool Knight::generateMoves(const Board& board, const std::array<int, 20>& box,
+                           const std::pair<int, int>& state, int origin,
+                           const MoveFactory& moveFactory, MoveList& moves,
+                           int stage) const {
+  return Leaper::generateMoves(board, origin, moveFactory, moves, stage);
 }
-
-bool Pawn::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory,
-    std::vector<std::unique_ptr<Move>>& moves) const {
-  int directions[] = {black_ ? -17 : -15, black_ ? 15 : 17};
-  for (int direction : directions) {
-    int target = origin + direction;
-    if (!(target & 136)) {
-      const std::unique_ptr<Piece>& piece = board.at(target);
-      if (piece) {
-        if (piece->isBlack() != black_) {
-          if (origin % 16 == (black_ ? 1 : 6)) {
-            const std::map<int, std::deque<std::unique_ptr<Piece>>>&
-                promotions = box.at(black_);
-            for (const std::pair<const int, std::deque<std::unique_ptr<Piece>>>&
-                     promotion : promotions) {
-              int order = promotion.first;
-              if (!moveFactory.generatePromotionCapture(
-                      board, box, origin, target, black_, order, moves)) {
-                return false;
-              }
-            }
-          } else {
-            if (!moveFactory.generateCapture(board, origin, target, moves)) {
-              return false;
-            }
-          }
-        }
-      } else {
-        const std::shared_ptr<int>& enPassant = state.second;
-        if (enPassant && target == *enPassant) {
-          int stop = target + (black_ ? 1 : -1);
-          if (!moveFactory.generateEnPassant(board, origin, target, stop,
-                                             moves)) {
-            return false;
-          }
-        }
-      }
-    }
-  }
-  int direction = black_ ? -1 : 1;
-  int target = origin + direction;
-  if (!(target & 136)) {
-    if (!board.at(target)) {
-      if (origin % 16 == (black_ ? 1 : 6)) {
-        const std::map<int, std::deque<std::unique_ptr<Piece>>>& promotions =
-            box.at(black_);
-        for (const std::pair<const int, std::deque<std::unique_ptr<Piece>>>&
-                 promotion : promotions) {
-          int order = promotion.first;
-          moveFactory.generatePromotion(board, box, origin, target, black_,
-                                        order, moves);
-        }
-      } else {
-        moveFactory.generateQuietMove(board, origin, target, moves);
-        if (origin % 16 == (black_ ? 6 : 1)) {
-          target = origin + 2 * direction;
-          if (!board.at(target)) {
-            int stop = origin + direction;
-            moveFactory.generateDoubleStep(board, origin, target, stop, moves);
-          }
-        }
-      }
-    }
-  }
-  return true;
+bool Knight::generateMoves(const Board& board, const std::array<int, 20>& box,
+                           const std::pair<int, int>& state, int origin,
+                           const MoveFactory& moveFactory,
+                           LegalMoveCounter& counter) const {
+  return Leaper::generateMoves(board, origin, moveFactory, counter);
 }
-bool Pawn::generateMoves(
-    const std::array<std::unique_ptr<Piece>, 128>& board,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-    const MoveFactory& moveFactory) const {
-  int directions[] = {black_ ? -17 : -15, black_ ? 15 : 17};
-  for (int direction : directions) {
-    int target = origin + direction;
-    if (!(target & 136)) {
-      const std::unique_ptr<Piece>& piece = board.at(target);
-      if (piece) {
-        if (piece->isBlack() != black_) {
-          if (origin % 16 == (black_ ? 1 : 6)) {
-            const std::map<int, std::deque<std::unique_ptr<Piece>>>&
-                promotions = box.at(black_);
-            for (const std::pair<const int, std::deque<std::unique_ptr<Piece>>>&
-                     promotion : promotions) {
-              int order = promotion.first;
-              if (!moveFactory.generatePromotionCapture(
-                      board, box, origin, target, black_, order)) {
-                return false;
-              }
-            }
-          } else {
-            if (!moveFactory.generateCapture(board, origin, target)) {
-              return false;
-            }
-          }
-        }
-      } else {
-        const std::shared_ptr<int>& enPassant = state.second;
-        if (enPassant && target == *enPassant) {
-          int stop = target + (black_ ? 1 : -1);
-          if (!moveFactory.generateEnPassant(board, origin, target, stop)) {
-            return false;
-          }
-        }
-      }
-    }
-  }
-  return true;
+
+bool Pawn::generateMoves(const Board& board, const std::array<int, 20>& box,
+                         const std::pair<int, int>& state, int origin,
+                         const MoveFactory& moveFactory, MoveList& moves,
+                         int stage) const {
+  return moveFactory.generatePawnMoves(board, box, state, origin, black_, moves,
+                                       stage);
+}
+bool Pawn::generateMoves(const Board& board, const std::array<int, 20>& box,
+                         const std::pair<int, int>& state, int origin,
+                         const MoveFactory& moveFactory,
+                         LegalMoveCounter& counter) const {
+  return moveFactory.generatePawnMoves(board, box, state, origin, black_,
+                                       counter);
 }
 
 std::string King::code(int translate) {
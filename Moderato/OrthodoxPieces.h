@@ -29,10 +29,8 @@
 namespace moderato {
 
 class King : public Piece, Leaper {
-  static std::vector<int>& leaps(
-      const std::array<std::unique_ptr<Piece>, 128>& board);
-  const std::vector<int>& getLeaps(
-      const std::array<std::unique_ptr<Piece>, 128>& board) const override;
+  static std::vector<int>& leaps(const Board& board);
+  const std::vector<int>& getLeaps(const Board& board) const override;
   std::string getName() const override;
 
  public:
@@ -40,138 +38,105 @@ class King : public Piece, Leaper {
   bool isBlack() const override;
   bool isRoyal() const override;
   bool isCastling() const override;
-  int findRebirthSquare(const std::array<std::unique_ptr<Piece>, 128>& board,
-                        int square, bool opposite) const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory) const override;
+  int findRebirthSquare(const Board& board, int square,
+                        bool opposite) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory, MoveList& moves,
+                     int stage) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory,
+                     LegalMoveCounter& counter) const override;
   static std::string code(int translate);
   std::string getCode(int translate) const override;
 };
 
 class Queen : public Piece, Rider {
-  static std::vector<int>& rides(
-      const std::array<std::unique_ptr<Piece>, 128>& board);
-  const std::vector<int>& getRides(
-      const std::array<std::unique_ptr<Piece>, 128>& board) const override;
+  static std::vector<int>& rides(const Board& board);
+  const std::vector<int>& getRides(const Board& board) const override;
   std::string getName() const override;
 
  public:
   Queen(bool black);
   bool isBlack() const override;
-  int findRebirthSquare(const std::array<std::unique_ptr<Piece>, 128>& board,
-                        int square, bool opposite) const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory) const override;
+  int findRebirthSquare(const Board& board, int square,
+                        bool opposite) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory, MoveList& moves,
+                     int stage) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory,
+                     LegalMoveCounter& counter) const override;
   static std::string code(int translate);
   std::string getCode(int translate) const override;
 };
 
 class Rook : public Piece, Rider {
-  static std::vector<int>& rides(
-      const std::array<std::unique_ptr<Piece>, 128>& board);
-  const std::vector<int>& getRides(
-      const std::array<std::unique_ptr<Piece>, 128>& board) const override;
+  static std::vector<int>& rides(const Board& board);
+  const std::vector<int>& getRides(const Board& board) const override;
   std::string getName() const override;
 
  public:
   Rook(bool black);
   bool isBlack() const override;
   bool isCastling() const override;
-  int findRebirthSquare(const std::array<std::unique_ptr<Piece>, 128>& board,
-                        int square, bool opposite) const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory) const override;
+  int findRebirthSquare(const Board& board, int square,
+                        bool opposite) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory, MoveList& moves,
+                     int stage) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory,
+                     LegalMoveCounter& counter) const override;
   static std::string code(int translate);
   std::string getCode(int translate) const override;
 };
 
 class Bishop : public Piece, Rider {
-  static std::vector<int>& rides(
-      const std::array<std::unique_ptr<Piece>, 128>& board);
-  const std::vector<int>& getRides(
-      const std::array<std::unique_ptr<Piece>, 128>& board) const override;
+  static std::vector<int>& rides(const Board& board);
+  const std::vector<int>& getRides(const Board& board) const override;
   std::string getName() const override;
 
  public:
   Bishop(bool black);
   bool isBlack() const override;
-  int findRebirthSquare(const std::array<std::unique_ptr<Piece>, 128>& board,
-                        int square, bool opposite) const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory) const override;
+  int findRebirthSquare(const Board& board, int square,
+                        bool opposite) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory, MoveList& moves,
+                     int stage) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory,
+                     LegalMoveCounter& counter) const override;
   static std::string code(int translate);
   std::string getCode(int translate) const override;
 };
 
 class Knight : public Piece, Leaper {
-  static std::vector<int>& leaps(
-      const std::array<std::unique_ptr<Piece>, 128>& board);
-  const std::vector<int>& getLeaps(
-      const std::array<std::unique_ptr<Piece>, 128>& board) const override;
+  static std::vector<int>& leaps(const Board& board);
+  const std::vector<int>& getLeaps(const Board& board) const override;
   std::string getName() const override;
 
  public:
   Knight(bool black);
   bool isBlack() const override;
-  int findRebirthSquare(const std::array<std::unique_ptr<Piece>, 128>& board,
-                        int square, bool opposite) const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory) const override;
+  int findRebirthSquare(const Board& board, int square,
+                        bool opposite) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory, MoveList& moves,
+                     int stage) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory,
+                     LegalMoveCounter& counter) const override;
   static std::string code(int translate);
   std::string getCode(int translate) const override;
 };
@@ -181,21 +146,16 @@ class Pawn : public Piece {
 
  public:
   Pawn(bool black);
-  int findRebirthSquare(const std::array<std::unique_ptr<Piece>, 128>& board,
-                        int square, bool opposite) const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory,
-      std::vector<std::unique_ptr<Move>>& moves) const override;
-  bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory) const override;
+  int findRebirthSquare(const Board& board, int square,
+                        bool opposite) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory, MoveList& moves,
+                     int stage) const override;
+  bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                     const std::pair<int, int>& state, int origin,
+                     const MoveFactory& moveFactory,
+                     LegalMoveCounter& counter) const override;
   static std::string code(int translate);
   std::string getCode(int translate) const override;
 };
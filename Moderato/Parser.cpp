@@ -27,6 +27,7 @@
 #include <iterator>
 #include <numeric>
 #include <regex>
+#include <set>
 #include <sstream>
 #include <stdexcept>
 
@@ -34,6 +35,7 @@
 #include "FairyPieces.h"
 #include "OrthodoxPieces.h"
 #include "ProblemTypes.h"
+#include "SpecialisedMoveFactory.h"
 
 namespace moderato {
 
@@ -72,6 +74,9 @@ struct Stipulation {
 struct Options {
   bool tri;
   int defence;
+  int hashSize;
+  std::string hashFile;
+  int threads;
   bool setPlay;
   bool nullMoves;
   bool whiteToPlay;
@@ -104,8 +109,8 @@ struct Problem {
 void validateProblem(const popeye::Problem& specification);
 void verifyProblem(const popeye::Problem& specification);
 Task convertProblem(const popeye::Problem& specification, int inputLanguage);
-std::unique_ptr<Piece> convertPieceTypeAndColour(
-    const popeye::PieceType& pieceType, const popeye::Colour& colour);
+unsigned char convertPieceTypeAndColour(const popeye::PieceType& pieceType,
+                                        const popeye::Colour& colour);
 bool convertColour(const popeye::Colour& colour);
 
 namespace model {
@@ -147,9 +152,12 @@ struct Position {
 
 void validatePosition(const model::Position& specification);
 Task convertPosition(const model::Position& specification);
-std::unique_ptr<Piece> convertPiece(const model::Piece& piece);
+unsigned char convertPiece(const model::Piece& piece);
 bool convertColour(const model::Colour& colour);
 
+std::vector<std::vector<std::string>> commandTerms();
+std::vector<std::vector<std::string>> directiveTerms();
+std::vector<std::vector<std::string>> optionTerms();
 std::vector<std::vector<std::string>> pieceTypeCodes();
 
 bool translateTerm(const std::vector<std::vector<std::string>>& translations,
@@ -158,6 +166,7 @@ bool translateTerm(const std::vector<std::vector<std::string>>& translations,
 bool translatePattern(const std::vector<std::vector<std::string>>& translations,
                       int inputLanguage, int outputLanguage,
                       const std::string& input, std::string& output);
+int toSearchPlies(int nPlies);
 
 std::istream& operator>>(std::istream& input, std::vector<Task>& tasks) {
   std::vector<std::string> transitions = {"Popeye", "1"};
@@ -202,13 +211,8 @@ std::istream& operator>>(std::istream& input, std::vector<Task>& tasks) {
                   }
                 } else if (transition == "Problem") {
                   std::string command;
-                  if (translateTerm({{"Remark", "Remarque", "Bemerkung"},
-                                     {"Condition", "Condition", "Bedingung"},
-                                     {"Option", "Option", "Option"},
-                                     {"Stipulation", "Enonce", "Forderung"},
-                                     {"Pieces", "Pieces", "Steine"}},
-                                    inputLanguage, Piece::ENGLISH, token,
-                                    command)) {
+                  if (translateTerm(commandTerms(), inputLanguage,
+                                    Piece::ENGLISH, token, command)) {
                     if (command == "Condition" || command == "Option" ||
                         command == "Stipulation" || command == "Pieces") {
                       transitions = {command};
@@ -221,10 +225,8 @@ std::istream& operator>>(std::istream& input, std::vector<Task>& tasks) {
                     return true;
                   }
                   std::string directive;
-                  if (translateTerm(
-                          {{"EndProblem", "FinProbleme", "Endeproblem"},
-                           {"NextProblem", "ASuivre", "WeiteresProblem"}},
-                          inputLanguage, Piece::ENGLISH, token, directive)) {
+                  if (translateTerm(directiveTerms(), inputLanguage,
+                                    Piece::ENGLISH, token, directive)) {
                     if (directive == "NextProblem") {
                       transitions = {"Problem"};
                     } else if (directive == "EndProblem") {
@@ -279,24 +281,11 @@ std::istream& operator>>(std::istream& input, std::vector<Task>& tasks) {
                   }
                 } else if (transition == "Option") {
                   std::string option;
-                  if (translateTerm(
-                          {{"Try", "Essais", "Verfuehrung"},
-                           {"Defence", "Defense", "Widerlegung"},
-                           {"SetPlay", "Apparent", "Satzspiel"},
-                           {"NullMoves", "CoupsVides", "NullZuege"},
-                           {"WhiteToPlay", "ApparentSeul", "WeissBeginnt"},
-                           {"Variation", "Variantes", "Varianten"},
-                           {"MoveNumbers", "Trace", "Zugnummern"},
-                           {"NoThreat", "SansMenace", "OhneDrohung"},
-                           {"EnPassant", "EnPassant", "EnPassant"},
-                           {"NoBoard", "SansEchiquier", "OhneBrett"},
-                           {"NoShortVariations", "SansVariantesCourtes",
-                            "OhneKurzVarianten"},
-                           {"HalfDuplex", "DemiDuplex", "HalbDuplex"},
-                           {"NoCastling", "SansRoquer", "KeineRochade"}},
-                          inputLanguage, Piece::ENGLISH, token, option)) {
-                    if (option == "Defence" || option == "EnPassant" ||
-                        option == "NoCastling") {
+                  if (translateTerm(optionTerms(), inputLanguage,
+                                    Piece::ENGLISH, token, option)) {
+                    if (option == "Defence" || option == "HashSize" ||
+                        option == "HashFile" || option == "Threads" ||
+                        option == "EnPassant" || option == "NoCastling") {
                       transitions = {option};
                     } else {
                       (option == "Try"           ? problem.options.tri
@@ -322,6 +311,34 @@ std::istream& operator>>(std::istream& input, std::vector<Task>& tasks) {
                     transitions = {"Option", "Problem"};
                     return true;
                   }
+                } else if (transition == "HashSize") {
+                  if (std::regex_match(token, std::regex("[1-9]\\d{0,4}"))) {
+                    int hashSize = std::stoi(token);
+                    problem.options.hashSize = hashSize;
+                    transitions = {"Option", "Problem"};
+                    return true;
+                  }
+                } else if (transition == "HashFile") {
+                  std::string keyword;
+                  if (translateTerm(commandTerms(), inputLanguage,
+                                    Piece::ENGLISH, token, keyword) ||
+                      translateTerm(directiveTerms(), inputLanguage,
+                                    Piece::ENGLISH, token, keyword) ||
+                      translateTerm(optionTerms(), inputLanguage,
+                                    Piece::ENGLISH, token, keyword)) {
+                    throw std::invalid_argument(
+                        "Parse failure (missing operand: HashFile).");
+                  }
+                  problem.options.hashFile = token;
+                  transitions = {"Option", "Problem"};
+                  return true;
+                } else if (transition == "Threads") {
+                  if (std::regex_match(token, std::regex("[1-9]\\d{0,2}"))) {
+                    int threads = std::stoi(token);
+                    problem.options.threads = threads;
+                    transitions = {"Option", "Problem"};
+                    return true;
+                  }
                 } else if (transition == "EnPassant" ||
                            transition == "NoCastling") {
                   if (std::regex_match(token,
@@ -351,7 +368,7 @@ std::istream& operator>>(std::istream& input, std::vector<Task>& tasks) {
                   }
                 } else if (transition == "Stipulation") {
                   std::string stipulationPattern =
-                      "(|[Hh]|[Ss])(#|=)([1-9]\\d*)";
+                      "(|[Hh]|[Ss])(#|=)([1-9]\\d{0,2})";
                   if (std::regex_match(token, std::regex(stipulationPattern))) {
                     std::smatch stipulationMatch;
                     std::regex_match(token, stipulationMatch,
@@ -368,9 +385,11 @@ std::istream& operator>>(std::istream& input, std::vector<Task>& tasks) {
                                             ? popeye::Stalemate
                                             : popeye::Mate;
                     int nMoves = std::stoi(stipulationMatch[3]);
-                    problem.stipulation = {stipulationType, goal, nMoves};
-                    transitions = {"Problem"};
-                    return true;
+                    if (toSearchPlies(2 * nMoves) <= Position::MAX_PLY) {
+                      problem.stipulation = {stipulationType, goal, nMoves};
+                      transitions = {"Problem"};
+                      return true;
+                    }
                   }
                 } else if (transition == "Pieces") {
                   std::string colour;
@@ -523,21 +542,25 @@ std::istream& operator>>(std::istream& input, std::vector<Task>& tasks) {
                 } else if (transition == "acd" || transition == "dm") {
                   if (std::regex_match(
                           token,
-                          std::regex(transition == "acd" ? "(0|[1-9]\\d*);"
+                          std::regex(transition == "acd" ? "(0|[1-9]\\d{0,2});"
                                      : transition == "dm"
-                                         ? "[1-9]\\d*;"
+                                         ? "[1-9]\\d{0,2};"
                                          : throw transition))) {
                     model::Opcode opcode = transition == "acd" ? model::ACD
                                            : transition == "dm"
                                                ? model::DM
                                                : throw transition;
                     int operand = std::stoi(token);
-                    position.operation = {opcode, operand};
-                    hasNextLine = true;
-                    transitions = {};
-                    positions.push_back(position);
-                    position = {};
-                    return true;
+                    if (toSearchPlies(opcode == model::ACD ? operand
+                                                           : 2 * operand) <=
+                        Position::MAX_PLY) {
+                      position.operation = {opcode, operand};
+                      hasNextLine = true;
+                      transitions = {};
+                      positions.push_back(position);
+                      position = {};
+                      return true;
+                    }
                   }
                 } else {
                   throw transition;
@@ -742,12 +765,13 @@ void verifyProblem(const popeye::Problem& specification) {
   }
 }
 Task convertProblem(const popeye::Problem& specification, int inputLanguage) {
-  std::array<std::unique_ptr<Piece>, 128> board;
+  Board board;
   for (const popeye::Piece& piece : specification.pieces) {
     int square = 16 * piece.square.file + piece.square.rank;
-    board.at(square) = convertPieceTypeAndColour(piece.pieceType, piece.colour);
+    board.place(square,
+                convertPieceTypeAndColour(piece.pieceType, piece.colour));
   }
-  std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>> box;
+  std::array<int, 20> box = {};
   std::set<popeye::PieceType> promotionTypes = {popeye::Queen, popeye::Rook,
                                                 popeye::Bishop, popeye::Knight};
   for (const popeye::Piece& piece : specification.pieces) {
@@ -799,18 +823,10 @@ Task convertProblem(const popeye::Problem& specification, int inputLanguage) {
       iPiece++;
     }
     int maxPromotion = std::min(maxMove, nPawns);
-    if (maxPromotion) {
-      bool black = convertColour(colour);
-      for (int promotionNo = maxPromotion; promotionNo--;) {
-        int order = 0;
-        for (const popeye::PieceType& promotionType : promotionTypes) {
-          box[black][++order].push_front(
-              convertPieceTypeAndColour(promotionType, colour));
-        }
-      }
+    for (const popeye::PieceType& promotionType : promotionTypes) {
+      box[convertPieceTypeAndColour(promotionType, colour)] = maxPromotion;
     }
   }
-  std::stack<std::unique_ptr<Piece>> table;
   bool blackToMove =
       specification.stipulation.stipulationType == popeye::Direct ||
               specification.stipulation.stipulationType == popeye::Self
@@ -819,7 +835,7 @@ Task convertProblem(const popeye::Problem& specification, int inputLanguage) {
           ? specification.options.halfDuplex ==
                 specification.options.whiteToPlay
           : throw specification.stipulation.stipulationType;
-  std::pair<std::set<int>, std::shared_ptr<int>> state;
+  std::pair<int, int> state(0, -1);
   std::vector<popeye::Piece>::const_iterator iPiece =
       specification.pieces.cbegin();
   std::vector<popeye::Piece>::const_iterator nPiece =
@@ -850,61 +866,71 @@ Task convertProblem(const popeye::Problem& specification, int inputLanguage) {
                                 square.rank == iPiece->square.rank;
                        })) {
         int square = 16 * iPiece->square.file + iPiece->square.rank;
-        state.first.insert(square);
+        state.first |= Board::toCastling(square);
       }
     }
     iPiece++;
   }
   for (const popeye::Square& target : specification.options.enPassant) {
     int square = 16 * target.file + target.rank;
-    state.second = std::make_shared<int>(square);
+    state.second = square;
   }
-  std::stack<std::pair<std::set<int>, std::shared_ptr<int>>> memory;
   std::unique_ptr<MoveFactory> moveFactory;
   if (specification.conditions.noCapture) {
     if (specification.conditions.antiAndernachChess) {
-      moveFactory = std::make_unique<NoCaptureAntiAndernachMoveFactory>();
+      moveFactory = std::make_unique<
+          SpecialisedMoveFactory<NoCaptureAntiAndernachMoveFactory>>();
     } else {
-      moveFactory = std::make_unique<NoCaptureMoveFactory>();
+      moveFactory =
+          std::make_unique<SpecialisedMoveFactory<NoCaptureMoveFactory>>();
     }
   } else if (specification.conditions.circe) {
     if (specification.conditions.andernachChess) {
-      moveFactory = std::make_unique<CirceAndernachMoveFactory>();
+      moveFactory =
+          std::make_unique<SpecialisedMoveFactory<CirceAndernachMoveFactory>>();
     } else if (specification.conditions.antiAndernachChess) {
-      moveFactory = std::make_unique<CirceAntiAndernachMoveFactory>();
+      moveFactory = std::make_unique<
+          SpecialisedMoveFactory<CirceAntiAndernachMoveFactory>>();
     } else {
-      moveFactory = std::make_unique<CirceMoveFactory>();
+      moveFactory =
+          std::make_unique<SpecialisedMoveFactory<CirceMoveFactory>>();
     }
   } else if (specification.conditions.antiCirce) {
     if (specification.conditions.antiCirce == popeye::Calvet) {
       if (specification.conditions.andernachChess) {
-        moveFactory = std::make_unique<AntiCirceAndernachMoveFactory>(true);
+        moveFactory = std::make_unique<
+            SpecialisedMoveFactory<AntiCirceAndernachMoveFactory>>(true);
       } else if (specification.conditions.antiAndernachChess) {
-        moveFactory = std::make_unique<AntiCirceAntiAndernachMoveFactory>(true);
+        moveFactory = std::make_unique<
+            SpecialisedMoveFactory<AntiCirceAntiAndernachMoveFactory>>(true);
       } else {
-        moveFactory = std::make_unique<AntiCirceMoveFactory>(true);
+        moveFactory = std::make_unique<
+            SpecialisedMoveFactory<AntiCirceMoveFactory>>(true);
       }
     } else if (specification.conditions.antiCirce == popeye::Cheylan) {
       if (specification.conditions.andernachChess) {
-        moveFactory = std::make_unique<AntiCirceAndernachMoveFactory>(false);
+        moveFactory = std::make_unique<
+            SpecialisedMoveFactory<AntiCirceAndernachMoveFactory>>(false);
       } else if (specification.conditions.antiAndernachChess) {
-        moveFactory =
-            std::make_unique<AntiCirceAntiAndernachMoveFactory>(false);
+        moveFactory = std::make_unique<
+            SpecialisedMoveFactory<AntiCirceAntiAndernachMoveFactory>>(false);
       } else {
-        moveFactory = std::make_unique<AntiCirceMoveFactory>(false);
+        moveFactory = std::make_unique<
+            SpecialisedMoveFactory<AntiCirceMoveFactory>>(false);
       }
     } else {
       throw specification.conditions.antiCirce;
     }
   } else if (specification.conditions.andernachChess) {
-    moveFactory = std::make_unique<AndernachMoveFactory>();
+    moveFactory =
+        std::make_unique<SpecialisedMoveFactory<AndernachMoveFactory>>();
   } else if (specification.conditions.antiAndernachChess) {
-    moveFactory = std::make_unique<AntiAndernachMoveFactory>();
+    moveFactory =
+        std::make_unique<SpecialisedMoveFactory<AntiAndernachMoveFactory>>();
   } else {
-    moveFactory = std::make_unique<MoveFactory>();
+    moveFactory = std::make_unique<SpecialisedMoveFactory<MoveFactory>>();
   }
-  Position position(std::move(board), std::move(box), std::move(table),
-                    blackToMove, std::move(state), std::move(memory),
+  Position position(std::move(board), box, blackToMove, state,
                     std::move(moveFactory));
   bool stalemate = specification.stipulation.goal == popeye::Mate ? false
                    : specification.stipulation.goal == popeye::Stalemate
@@ -977,8 +1003,16 @@ Task convertProblem(const popeye::Problem& specification, int inputLanguage) {
       : specification.stipulation.stipulationType == popeye::Help
           ? specification.options.nullMoves || specification.options.tri
           : throw specification.stipulation.stipulationType;
-  AnalysisOptions analysisOptions = {setPlay, nRefutations,    variations,
-                                     threats, shortVariations, tempoTries};
+  int hashSize = specification.options.hashSize
+                     ? specification.options.hashSize
+                     : AnalysisOptions().hashSize;
+  std::string hashFile = specification.options.hashFile;
+  int nThreads = specification.options.threads
+                     ? specification.options.threads
+                     : AnalysisOptions().nThreads;
+  AnalysisOptions analysisOptions = {
+      setPlay,    nRefutations, variations, threats, shortVariations,
+      tempoTries, hashSize,     hashFile,   nThreads};
   int outputLanguage = inputLanguage;
   bool internalModel = !specification.options.noBoard;
   bool internalProgress = specification.options.moveNumbers;
@@ -986,28 +1020,28 @@ Task convertProblem(const popeye::Problem& specification, int inputLanguage) {
                                    internalProgress};
   return {std::move(problem), analysisOptions, displayOptions};
 }
-std::unique_ptr<Piece> convertPieceTypeAndColour(
-    const popeye::PieceType& pieceType, const popeye::Colour& colour) {
+unsigned char convertPieceTypeAndColour(const popeye::PieceType& pieceType,
+                                        const popeye::Colour& colour) {
   bool black = convertColour(colour);
   switch (pieceType) {
     case popeye::King:
-      return std::make_unique<King>(black);
+      return Board::toCode(Board::KING, black);
     case popeye::Queen:
-      return std::make_unique<Queen>(black);
+      return Board::toCode(Board::QUEEN, black);
     case popeye::Rook:
-      return std::make_unique<Rook>(black);
+      return Board::toCode(Board::ROOK, black);
     case popeye::Bishop:
-      return std::make_unique<Bishop>(black);
+      return Board::toCode(Board::BISHOP, black);
     case popeye::Knight:
-      return std::make_unique<Knight>(black);
+      return Board::toCode(Board::KNIGHT, black);
     case popeye::Pawn:
-      return std::make_unique<Pawn>(black);
+      return Board::toCode(Board::PAWN, black);
     case popeye::Grasshopper:
-      return std::make_unique<Grasshopper>(black);
+      return Board::toCode(Board::GRASSHOPPER, black);
     case popeye::Nightrider:
-      return std::make_unique<Nightrider>(black);
+      return Board::toCode(Board::NIGHTRIDER, black);
     case popeye::Amazon:
-      return std::make_unique<Amazon>(black);
+      return Board::toCode(Board::AMAZON, black);
   }
   throw pieceType;
 }
@@ -1080,15 +1114,15 @@ void validatePosition(const model::Position& specification) {
   }
 }
 Task convertPosition(const model::Position& specification) {
-  std::array<std::unique_ptr<Piece>, 128> board;
+  Board board;
   for (int index = 0; index < 64; index++) {
     const model::Piece& piece = specification.board.at(index);
     if (piece != 0) {
       int square = 16 * (index % 8) + 7 - index / 8;
-      board.at(square) = convertPiece(piece);
+      board.place(square, convertPiece(piece));
     }
   }
-  std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>> box;
+  std::array<int, 20> box = {};
   for (const model::Colour& colour : {model::White, model::Black}) {
     int maxMove = specification.operation.opcode == model::ACD
                       ? (specification.sideToMove == colour
@@ -1117,19 +1151,12 @@ Task convertPosition(const model::Position& specification) {
                                  : colour == model::Black ? model::BlackKnight
                                                           : throw colour};
     int maxPromotion = std::min(maxMove, nPawns);
-    if (maxPromotion) {
-      bool black = convertColour(colour);
-      for (int promotionNo = maxPromotion; promotionNo--;) {
-        int order = 0;
-        for (const model::Piece& promotion : promotions) {
-          box[black][++order].push_front(convertPiece(promotion));
-        }
-      }
+    for (const model::Piece& promotion : promotions) {
+      box[convertPiece(promotion)] = maxPromotion;
     }
   }
-  std::stack<std::unique_ptr<Piece>> table;
   bool blackToMove = convertColour(specification.sideToMove);
-  std::pair<std::set<int>, std::shared_ptr<int>> state;
+  std::pair<int, int> state(0, -1);
   for (const model::Castling& castling : specification.castlings) {
     for (int index :
          {castling == model::WhiteShort || castling == model::WhiteLong ? 60
@@ -1142,18 +1169,17 @@ Task convertPosition(const model::Position& specification) {
           : castling == model::BlackLong  ? 0
                                           : throw castling}) {
       int square = 16 * (index % 8) + 7 - index / 8;
-      state.first.insert(square);
+      state.first |= Board::toCastling(square);
     }
   }
   if (specification.enPassant.present) {
     int square = 16 * (specification.enPassant.index % 8) + 7 -
                  specification.enPassant.index / 8;
-    state.second = std::make_shared<int>(square);
+    state.second = square;
   }
-  std::stack<std::pair<std::set<int>, std::shared_ptr<int>>> memory;
-  std::unique_ptr<MoveFactory> moveFactory = std::make_unique<MoveFactory>();
-  Position position(std::move(board), std::move(box), std::move(table),
-                    blackToMove, std::move(state), std::move(memory),
+  std::unique_ptr<MoveFactory> moveFactory =
+      std::make_unique<SpecialisedMoveFactory<MoveFactory>>();
+  Position position(std::move(board), box, blackToMove, state,
                     std::move(moveFactory));
   int nMoves = specification.operation.opcode == model::ACD
                    ? specification.operation.operand / 2
@@ -1177,34 +1203,34 @@ Task convertPosition(const model::Position& specification) {
   DisplayOptions displayOptions;
   return {std::move(problem), analysisOptions, displayOptions};
 }
-std::unique_ptr<Piece> convertPiece(const model::Piece& piece) {
+unsigned char convertPiece(const model::Piece& piece) {
   switch (piece) {
     case 0:
-      return nullptr;
+      return 0;
     case model::WhiteKing:
-      return std::make_unique<King>(false);
+      return Board::toCode(Board::KING, false);
     case model::WhiteQueen:
-      return std::make_unique<Queen>(false);
+      return Board::toCode(Board::QUEEN, false);
     case model::WhiteRook:
-      return std::make_unique<Rook>(false);
+      return Board::toCode(Board::ROOK, false);
     case model::WhiteBishop:
-      return std::make_unique<Bishop>(false);
+      return Board::toCode(Board::BISHOP, false);
     case model::WhiteKnight:
-      return std::make_unique<Knight>(false);
+      return Board::toCode(Board::KNIGHT, false);
     case model::WhitePawn:
-      return std::make_unique<Pawn>(false);
+      return Board::toCode(Board::PAWN, false);
     case model::BlackKing:
-      return std::make_unique<King>(true);
+      return Board::toCode(Board::KING, true);
     case model::BlackQueen:
-      return std::make_unique<Queen>(true);
+      return Board::toCode(Board::QUEEN, true);
     case model::BlackRook:
-      return std::make_unique<Rook>(true);
+      return Board::toCode(Board::ROOK, true);
     case model::BlackBishop:
-      return std::make_unique<Bishop>(true);
+      return Board::toCode(Board::BISHOP, true);
     case model::BlackKnight:
-      return std::make_unique<Knight>(true);
+      return Board::toCode(Board::KNIGHT, true);
     case model::BlackPawn:
-      return std::make_unique<Pawn>(true);
+      return Board::toCode(Board::PAWN, true);
   }
   throw piece;
 }
@@ -1275,6 +1301,36 @@ bool translatePattern(const std::vector<std::vector<std::string>>& translations,
   return false;
 }
 
+std::vector<std::vector<std::string>> commandTerms() {
+  return {{"Remark", "Remarque", "Bemerkung"},
+          {"Condition", "Condition", "Bedingung"},
+          {"Option", "Option", "Option"},
+          {"Stipulation", "Enonce", "Forderung"},
+          {"Pieces", "Pieces", "Steine"}};
+}
+std::vector<std::vector<std::string>> directiveTerms() {
+  return {{"EndProblem", "FinProbleme", "Endeproblem"},
+          {"NextProblem", "ASuivre", "WeiteresProblem"}};
+}
+std::vector<std::vector<std::string>> optionTerms() {
+  return {{"Try", "Essais", "Verfuehrung"},
+          {"Defence", "Defense", "Widerlegung"},
+          {"HashSize", "TailleHash", "HashGroesse"},
+          {"HashFile", "FichierHash", "HashDatei"},
+          {"Threads", "Fils", "Faeden"},
+          {"SetPlay", "Apparent", "Satzspiel"},
+          {"NullMoves", "CoupsVides", "NullZuege"},
+          {"WhiteToPlay", "ApparentSeul", "WeissBeginnt"},
+          {"Variation", "Variantes", "Varianten"},
+          {"MoveNumbers", "Trace", "Zugnummern"},
+          {"NoThreat", "SansMenace", "OhneDrohung"},
+          {"EnPassant", "EnPassant", "EnPassant"},
+          {"NoBoard", "SansEchiquier", "OhneBrett"},
+          {"NoShortVariations", "SansVariantesCourtes",
+           "OhneKurzVarianten"},
+          {"HalfDuplex", "DemiDuplex", "HalbDuplex"},
+          {"NoCastling", "SansRoquer", "KeineRochade"}};
+}
 std::vector<std::vector<std::string>> pieceTypeCodes() {
   return {{King::code(Piece::ENGLISH), King::code(Piece::FRENCH),
            King::code(Piece::GERMAN)},
@@ -1296,4 +1352,10 @@ std::vector<std::vector<std::string>> pieceTypeCodes() {
            Amazon::code(Piece::GERMAN)}};
 }
 
+int toSearchPlies(int nPlies) {
+  // Set play and half moves add a ply before the play, and the terminal
+  // legality tests and move annotations add plies after it.
+  return nPlies + 4;
+}
+
 }  // namespace moderato
@@ -28,7 +28,6 @@ namespace moderato {
 
 Piece::Piece(bool black) : black_(black) {}
 Piece::~Piece() {}
-bool& Piece::isBlack() { return black_; }
 bool Piece::isBlack() const { return black_; }
 bool Piece::isRoyal() const { return false; }
 bool Piece::isCastling() const { return false; }
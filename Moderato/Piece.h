@@ -25,19 +25,18 @@
 #pragma once
 
 #include <array>
-#include <deque>
-#include <map>
 #include <memory>
 #include <ostream>
-#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace moderato {
 
-class Move;
+class Board;
 class MoveFactory;
+class LegalMoveCounter;
+class MoveList;
 
 class Piece {
   virtual std::string getName() const = 0;
@@ -48,26 +47,20 @@ class Piece {
 
  public:
   virtual ~Piece();
-  bool& isBlack();
   bool isBlack() const;
   virtual bool isRoyal() const;
   virtual bool isCastling() const;
-  virtual int findRebirthSquare(
-      const std::array<std::unique_ptr<Piece>, 128>& board, int square,
-      bool opposite) const = 0;
-  virtual bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory,
-      std::vector<std::unique_ptr<Move>>& moves) const = 0;
-  virtual bool generateMoves(
-      const std::array<std::unique_ptr<Piece>, 128>& board,
-      const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-          box,
-      const std::pair<std::set<int>, std::shared_ptr<int>>& state, int origin,
-      const MoveFactory& moveFactory) const = 0;
+  virtual int findRebirthSquare(const Board& board, int square,
+                                bool opposite) const = 0;
+  enum { CAPTURES = 1, QUIET_MOVES, ALL_MOVES };
+  virtual bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                             const std::pair<int, int>& state, int origin,
+                             const MoveFactory& moveFactory, MoveList& moves,
+                             int stage) const = 0;
+  virtual bool generateMoves(const Board& board, const std::array<int, 20>& box,
+                             const std::pair<int, int>& state, int origin,
+                             const MoveFactory& moveFactory,
+                             LegalMoveCounter& counter) const = 0;
   enum { ENGLISH = 1, FRENCH, GERMAN };
   virtual std::string getCode(int translate) const = 0;
   friend std::ostream& operator<<(std::ostream& output, const Piece& piece);
@@ -28,166 +28,43 @@
 
 namespace moderato {
 
-bool Leaper::generateMoves(const std::array<std::unique_ptr<Piece>, 128>& board,
-                           int origin, const MoveFactory& moveFactory,
-                           std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::vector<int>& directions = getLeaps(board);
-  for (int direction : directions) {
-    int target = origin + direction;
-    if (!(target & 136)) {
-      const std::unique_ptr<Piece>& piece = board.at(target);
-      if (piece) {
-        if (piece->isBlack() != isBlack()) {
-          if (!moveFactory.generateCapture(board, origin, target, moves)) {
-            return false;
-          }
-        }
-      } else {
-        moveFactory.generateQuietMove(board, origin, target, moves);
-      }
-    }
-  }
-  return true;
+bool Leaper::generateMoves(const Board& board, int origin,
+                           const MoveFactory& moveFactory, MoveList& moves,
+                           int stage) const {
+  return moveFactory.generateLeaps(board, origin, isBlack(), getLeaps(board),
+                                   moves, stage);
 }
-bool Leaper::generateMoves(const std::array<std::unique_ptr<Piece>, 128>& board,
-                           int origin, const MoveFactory& moveFactory) const {
-  const std::vector<int>& directions = getLeaps(board);
-  for (int direction : directions) {
-    int target = origin + direction;
-    if (!(target & 136)) {
-      const std::unique_ptr<Piece>& piece = board.at(target);
-      if (piece) {
-        if (piece->isBlack() != isBlack()) {
-          if (!moveFactory.generateCapture(board, origin, target)) {
-            return false;
-          }
-        }
-      }
-    }
-  }
-  return true;
+bool Leaper::generateMoves(const Board& board, int origin,
+                           const MoveFactory& moveFactory,
+                           LegalMoveCounter& counter) const {
+  return moveFactory.generateLeaps(board, origin, isBlack(), getLeaps(board),
+                                   counter);
 }
 
-bool Rider::generateMoves(const std::array<std::unique_ptr<Piece>, 128>& board,
-                          int origin, const MoveFactory& moveFactory,
-                          std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::vector<int>& directions = getRides(board);
-  for (int direction : directions) {
-    int distance = 1;
-    while (true) {
-      int target = origin + distance * direction;
-      if (!(target & 136)) {
-        const std::unique_ptr<Piece>& piece = board.at(target);
-        if (piece) {
-          if (piece->isBlack() != isBlack()) {
-            if (!moveFactory.generateCapture(board, origin, target, moves)) {
-              return false;
-            }
-          }
-          break;
-        } else {
-          moveFactory.generateQuietMove(board, origin, target, moves);
-          distance++;
-        }
-      } else {
-        break;
-      }
-    }
-  }
-  return true;
+bool Rider::generateMoves(const Board& board, int origin,
+                          const MoveFactory& moveFactory, MoveList& moves,
+                          int stage) const {
+  return moveFactory.generateRides(board, origin, isBlack(), getRides(board),
+                                   moves, stage);
 }
-bool Rider::generateMoves(const std::array<std::unique_ptr<Piece>, 128>& board,
-                          int origin, const MoveFactory& moveFactory) const {
-  const std::vector<int>& directions = getRides(board);
-  for (int direction : directions) {
-    int distance = 1;
-    while (true) {
-      int target = origin + distance * direction;
-      if (!(target & 136)) {
-        const std::unique_ptr<Piece>& piece = board.at(target);
-        if (piece) {
-          if (piece->isBlack() != isBlack()) {
-            if (!moveFactory.generateCapture(board, origin, target)) {
-              return false;
-            }
-          }
-          break;
-        } else {
-          distance++;
-        }
-      } else {
-        break;
-      }
-    }
-  }
-  return true;
+bool Rider::generateMoves(const Board& board, int origin,
+                          const MoveFactory& moveFactory,
+                          LegalMoveCounter& counter) const {
+  return moveFactory.generateRides(board, origin, isBlack(), getRides(board),
+                                   counter);
 }
 
-bool Hopper::generateMoves(const std::array<std::unique_ptr<Piece>, 128>& board,
-                           int origin, const MoveFactory& moveFactory,
-                           std::vector<std::unique_ptr<Move>>& moves) const {
-  const std::vector<int>& directions = getHops(board);
-  for (int direction : directions) {
-    int distance = 1;
-    while (true) {
-      int target = origin + distance * direction;
-      if (!(target & 136)) {
-        if (board.at(target)) {
-          target = origin + (distance + 1) * direction;
-          if (!(target & 136)) {
-            const std::unique_ptr<Piece>& piece = board.at(target);
-            if (piece) {
-              if (piece->isBlack() != isBlack()) {
-                if (!moveFactory.generateCapture(board, origin, target,
-                                                 moves)) {
-                  return false;
-                }
-              }
-            } else {
-              moveFactory.generateQuietMove(board, origin, target, moves);
-            }
-          }
-          break;
-        } else {
-          distance++;
-        }
-      } else {
-        break;
-      }
-    }
-  }
-  return true;
+bool Hopper::generateMoves(const Board& board, int origin,
+                           const MoveFactory& moveFactory, MoveList& moves,
+                           int stage) const {
+  return moveFactory.generateHops(board, origin, isBlack(), getHops(board),
+                                  moves, stage);
 }
-bool Hopper::generateMoves(const std::array<std::unique_ptr<Piece>, 128>& board,
-                           int origin, const MoveFactory& moveFactory) const {
-  const std::vector<int>& directions = getHops(board);
-  for (int direction : directions) {
-    int distance = 1;
-    while (true) {
-      int target = origin + distance * direction;
-      if (!(target & 136)) {
-        if (board.at(target)) {
-          target = origin + (distance + 1) * direction;
-          if (!(target & 136)) {
-            const std::unique_ptr<Piece>& piece = board.at(target);
-            if (piece) {
-              if (piece->isBlack() != isBlack()) {
-                if (!moveFactory.generateCapture(board, origin, target)) {
-                  return false;
-                }
-              }
-            }
-          }
-          break;
-        } else {
-          distance++;
-        }
-      } else {
-        break;
-      }
-    }
-  }
-  return true;
+bool Hopper::generateMoves(const Board& board, int origin,
+                           const MoveFactory& moveFactory,
+                           LegalMoveCounter& counter) const {
+  return moveFactory.generateHops(board, origin, isBlack(), getHops(board),
+                                  counter);
 }
 
 }  // namespace moderato
@@ -30,41 +30,41 @@ namespace moderato {
 
 class Leaper {
   virtual bool isBlack() const = 0;
-  virtual const std::vector<int>& getLeaps(
-      const std::array<std::unique_ptr<Piece>, 128>& board) const = 0;
+  virtual const std::vector<int>& getLeaps(const Board& board) const = 0;
 
  protected:
-  bool generateMoves(const std::array<std::unique_ptr<Piece>, 128>& board,
-                     int origin, const MoveFactory& moveFactory,
-                     std::vector<std::unique_ptr<Move>>& moves) const;
-  bool generateMoves(const std::array<std::unique_ptr<Piece>, 128>& board,
-                     int origin, const MoveFactory& moveFactory) const;
+  bool generateMoves(const Board& board, int origin,
+                     const MoveFactory& moveFactory, MoveList& moves,
+                     int stage) const;
+  bool generateMoves(const Board& board, int origin,
+                     const MoveFactory& moveFactory,
+                     LegalMoveCounter& counter) const;
 };
 
 class Rider {
   virtual bool isBlack() const = 0;
-  virtual const std::vector<int>& getRides(
-      const std::array<std::unique_ptr<Piece>, 128>& board) const = 0;
+  virtual const std::vector<int>& getRides(const Board& board) const = 0;
 
  protected:
-  bool generateMoves(const std::array<std::unique_ptr<Piece>, 128>& board,
-                     int origin, const MoveFactory& moveFactory,
-                     std::vector<std::unique_ptr<Move>>& moves) const;
-  bool generateMoves(const std::array<std::unique_ptr<Piece>, 128>& board,
-                     int origin, const MoveFactory& moveFactory) const;
+  bool generateMoves(const Board& board, int origin,
+                     const MoveFactory& moveFactory, MoveList& moves,
+                     int stage) const;
+  bool generateMoves(const Board& board, int origin,
+                     const MoveFactory& moveFactory,
+                     LegalMoveCounter& counter) const;
 };
 
 class Hopper {
   virtual bool isBlack() const = 0;
-  virtual const std::vector<int>& getHops(
-      const std::array<std::unique_ptr<Piece>, 128>& board) const = 0;
+  virtual const std::vector<int>& getHops(const Board& board) const = 0;
 
  protected:
-  bool generateMoves(const std::array<std::unique_ptr<Piece>, 128>& board,
-                     int origin, const MoveFactory& moveFactory,
-                     std::vector<std::unique_ptr<Move>>& moves) const;
-  bool generateMoves(const std::array<std::unique_ptr<Piece>, 128>& board,
-                     int origin, const MoveFactory& moveFactory) const;
+  bool generateMoves(const Board& board, int origin,
+                     const MoveFactory& moveFactory, MoveList& moves,
+                     int stage) const;
+  bool generateMoves(const Board& board, int origin,
+                     const MoveFactory& moveFactory,
+                     LegalMoveCounter& counter) const;
 };
 
 }  // namespace moderato
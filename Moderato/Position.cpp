@@ -24,106 +24,222 @@
 
 #include "Position.h"
 
-#include "Move.h"
+#include "CheckInfo.h"
+#include "MoveSinks.h"
+#include "Zobrist.h"
 
 namespace moderato {
 
 std::ostream& operator<<(std::ostream& output,
-                         const std::array<std::unique_ptr<Piece>, 128>& board);
-std::ostream& operator<<(
-    std::ostream& output,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box);
+                         const std::array<int, 20>& box);
 std::ostream& operator<<(std::ostream& output,
-                         const std::stack<std::unique_ptr<Piece>>& table);
-std::ostream& operator<<(
-    std::ostream& output,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state);
-std::ostream& operator<<(
-    std::ostream& output,
-    const std::stack<std::pair<std::set<int>, std::shared_ptr<int>>>& memory);
+                         const std::pair<int, int>& state);
 
-Position::Position(
-    std::array<std::unique_ptr<Piece>, 128> board,
-    std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>> box,
-    std::stack<std::unique_ptr<Piece>> table, bool blackToMove,
-    std::pair<std::set<int>, std::shared_ptr<int>> state,
-    std::stack<std::pair<std::set<int>, std::shared_ptr<int>>> memory,
-    std::unique_ptr<MoveFactory> moveFactory)
-    : board_(std::move(board)),
-      box_(std::move(box)),
-      table_(std::move(table)),
+Position::Position(Board board, std::array<int, 20> box, bool blackToMove,
+                   std::pair<int, int> state,
+                   std::unique_ptr<MoveFactory> moveFactory)
+    : board_(board),
+      box_(box),
       blackToMove_(blackToMove),
-      state_(std::move(state)),
-      memory_(std::move(memory)),
-      moveFactory_(std::move(moveFactory)) {}
+      state_(state),
+      moveFactory_(std::move(moveFactory)),
+      stateKey_(hashState(state_) ^ (blackToMove_ ? hashSide() : 0)) {
+  checks_.fill(-1);
+}
+Position::Position(const Position& position)
+    : board_(position.board_),
+      box_(position.box_),
+      table_(position.table_),
+      blackToMove_(position.blackToMove_),
+      state_(position.state_),
+      memory_(position.memory_),
+      checks_(position.checks_),
+      ply_(position.ply_),
+      moveFactory_(position.moveFactory_->clone()),
+      stateKey_(position.stateKey_),
+      moves_(position.moves_) {}
 
-std::array<std::unique_ptr<Piece>, 128>& Position::getBoard() { return board_; }
-std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-Position::getBox() {
-  return box_;
+Board& Position::getBoard() { return board_; }
+std::array<int, 20>& Position::getBox() { return box_; }
+std::array<unsigned char, Position::MAX_PLY>& Position::getTable() {
+  return table_;
 }
-std::stack<std::unique_ptr<Piece>>& Position::getTable() { return table_; }
 bool& Position::isBlackToMove() { return blackToMove_; }
-std::pair<std::set<int>, std::shared_ptr<int>>& Position::getState() {
-  return state_;
-}
-std::stack<std::pair<std::set<int>, std::shared_ptr<int>>>&
-Position::getMemory() {
+std::pair<int, int>& Position::getState() { return state_; }
+std::array<std::pair<int, int>, Position::MAX_PLY>& Position::getMemory() {
   return memory_;
 }
-
-bool Position::isLegal(std::vector<std::unique_ptr<Move>>& pseudoLegalMoves) {
+std::array<int, Position::MAX_PLY + 1>& Position::getChecks() {
+  return checks_;
+}
+int& Position::getPly() { return ply_; }
+MoveList& Position::getMoves(int ply) {
+  while (static_cast<int>(moves_.size()) <= ply) {
+    moves_.emplace_back();
+  }
+  return moves_[ply];
+}
+std::uint64_t& Position::getStateKey() { return stateKey_; }
+const MoveFactory& Position::getMoveFactory() const { return *moveFactory_; }
+std::uint64_t Position::getKey() const {
+  return board_.getKey() ^ stateKey_ ^ hashBox(box_);
+}
+std::uint64_t Position::computeKey() const {
+  std::uint64_t key =
+      hashState(state_) ^ (blackToMove_ ? hashSide() : 0) ^ hashBox(box_);
   for (int square = 0; square < 128; square++) {
     if (!(square & 136)) {
-      const std::unique_ptr<Piece>& piece = board_.at(square);
-      if (piece && piece->isBlack() == blackToMove_) {
-        if (!piece->generateMoves(board_, box_, state_, square, *moveFactory_,
-                                  pseudoLegalMoves)) {
-          return false;
-        }
+      unsigned char code = board_.at(square);
+      if (code) {
+        key ^= hashPiece(code, square);
       }
     }
   }
-  return true;
+  return key;
 }
+
 bool Position::isLegal() {
-  for (int square = 0; square < 128; square++) {
-    if (!(square & 136)) {
-      const std::unique_ptr<Piece>& piece = board_.at(square);
-      if (piece && piece->isBlack() == blackToMove_) {
-        if (!piece->generateMoves(board_, box_, state_, square,
-                                  *moveFactory_)) {
-          return false;
+  int royal = board_.getRoyal(!blackToMove_);
+  return royal < 0 || !isAttacked(royal, blackToMove_);
+}
+bool Position::isAttacked(int square, bool black) {
+  return moveFactory_->isAttacked(board_, box_, square, black);
+}
+MoveList& Position::generateMoves() {
+  MoveList& pseudoLegalMoves = getMoves(ply_);
+  pseudoLegalMoves.clear();
+  generateMoves(pseudoLegalMoves, Piece::ALL_MOVES);
+  return pseudoLegalMoves;
+}
+MoveList& Position::generateLegalMoves() {
+  MoveList& legalMoves = generateMoves();
+  int royal = board_.getRoyal(blackToMove_);
+  if (royal < 0) {
+    return legalMoves;
+  }
+  bool check = isCheck() > 0;
+  std::array<bool, 128> lines = {};
+  if (moveFactory_->hasLocalMoves()) {
+    board_.findLines(royal, !blackToMove_, check, lines);
+  } else {
+    lines.fill(true);
+  }
+  int nLegalMoves = 0;
+  for (const Move& move : legalMoves) {
+    bool legal;
+    if (isLocal(move, royal, lines)) {
+      legal = !check;
+    } else {
+      legal = move.make(*this);
+      move.unmake(*this);
+    }
+    if (legal) {
+      legalMoves.begin()[nLegalMoves++] = move;
+    }
+  }
+  legalMoves.resize(nLegalMoves);
+  return legalMoves;
+}
+int Position::countLegalMoves(int limit) {
+  int royal = board_.getRoyal(blackToMove_);
+  bool check = royal >= 0 && isCheck() > 0;
+  std::array<bool, 128> lines = {};
+  if (royal >= 0 && moveFactory_->hasLocalMoves()) {
+    board_.findLines(royal, !blackToMove_, check, lines);
+  } else {
+    lines.fill(true);
+  }
+  LegalMoveCounter counter(*this, royal, check, lines, limit);
+  if (royal >= 0 && !check && moveFactory_->hasLocalMoves()) {
+    MoveList deferredMoves;
+    counter.defer(&deferredMoves);
+    if (generateMoves(counter, royal, false)) {
+      counter.defer(nullptr);
+      if (generateMoves(counter, royal, true)) {
+        for (const Move& move : deferredMoves) {
+          if (!counter.count(move)) {
+            break;
+          }
         }
       }
     }
+  } else {
+    if (generateMoves(counter, royal, true)) {
+      generateMoves(counter, royal, false);
+    }
+  }
+  return counter.getCount();
+}
+bool Position::hasLegalMove() { return countLegalMoves(1) > 0; }
+bool Position::isLocal(const Move& move, int royal,
+                       const std::array<bool, 128>& lines) const {
+  int kind = move.getKind();
+  return (kind == Move::QUIET_MOVE || kind == Move::CAPTURE ||
+          kind == Move::DOUBLE_STEP || kind == Move::PROMOTION ||
+          kind == Move::PROMOTION_CAPTURE) &&
+         move.getOrigin() != royal && !lines[move.getOrigin()] &&
+         !lines[move.getTarget()];
+}
+bool Position::generateMoves(LegalMoveCounter& counter, int royal,
+                             bool royalMoves) {
+  for (int square = board_.findFirst(blackToMove_); square < 128;
+       square = board_.findNext(blackToMove_, square)) {
+    if ((square == royal) == royalMoves &&
+        !board_.getPiece(square).generateMoves(board_, box_, state_, square,
+                                               *moveFactory_, counter)) {
+      return false;
+    }
+  }
+  return true;
+}
+bool Position::generateMoves(MoveList& pseudoLegalMoves, int stage) {
+  for (int square = board_.findFirst(blackToMove_); square < 128;
+       square = board_.findNext(blackToMove_, square)) {
+    if (!board_.getPiece(square).generateMoves(board_, box_, state_, square,
+                                               *moveFactory_, pseudoLegalMoves,
+                                               stage)) {
+      return false;
+    }
   }
   return true;
 }
+MoveList& Position::generateChecks() {
+  MoveList& pseudoLegalMoves = getMoves(ply_);
+  pseudoLegalMoves.clear();
+  generateChecks(pseudoLegalMoves, Piece::ALL_MOVES);
+  return pseudoLegalMoves;
+}
+bool Position::generateChecks(MoveList& pseudoLegalMoves, int stage) {
+  int size = pseudoLegalMoves.size();
+  if (!generateMoves(pseudoLegalMoves, stage)) {
+    return false;
+  }
+  CheckInfo checkInfo(board_, blackToMove_, *moveFactory_);
+  int nChecks = size;
+  for (Move* move = pseudoLegalMoves.begin() + size;
+       move != pseudoLegalMoves.end(); move++) {
+    if (checkInfo.mayGiveCheck(*move)) {
+      pseudoLegalMoves.begin()[nChecks++] = *move;
+    }
+  }
+  pseudoLegalMoves.resize(nChecks);
+  return true;
+}
 int Position::isCheck() {
-  NullMove nullMove;
-  nullMove.make(*this);
-  int nChecks = 0;
-  for (int square = 0; square < 128; square++) {
-    if (!(square & 136)) {
-      const std::unique_ptr<Piece>& piece = board_.at(square);
-      if (piece && piece->isBlack() == blackToMove_) {
-        if (!piece->generateMoves(board_, box_, state_, square,
-                                  *moveFactory_)) {
-          nChecks++;
-        }
-      }
+  int& nChecks = checks_[ply_];
+  if (nChecks < 0) {
+    int royal = board_.getRoyal(blackToMove_);
+    nChecks = 0;
+    if (royal >= 0) {
+      nChecks = moveFactory_->countAttacks(board_, box_, royal, !blackToMove_);
     }
   }
-  nullMove.unmake(*this);
   return nChecks;
 }
-bool Position::isTerminal(
-    const std::vector<std::unique_ptr<Move>>& pseudoLegalMoves) {
-  for (const std::unique_ptr<Move>& move : pseudoLegalMoves) {
-    bool result = move->make(*this);
-    move->unmake(*this);
+bool Position::isTerminal(const MoveList& pseudoLegalMoves) {
+  for (const Move& move : pseudoLegalMoves) {
+    bool result = move.make(*this);
+    move.unmake(*this);
     if (result) {
       return false;
     }
@@ -133,100 +249,58 @@ bool Position::isTerminal(
 
 std::ostream& operator<<(std::ostream& output, const Position& position) {
   output << "Position[board=" << position.board_ << ", box=" << position.box_
-         << ", table=" << position.table_
-         << ", blackToMove=" << position.blackToMove_
-         << ", state=" << position.state_ << ", memory=" << position.memory_
-         << ", moveFactory=*" << *position.moveFactory_ << "]";
-  return output;
-}
-std::ostream& operator<<(std::ostream& output,
-                         const std::array<std::unique_ptr<Piece>, 128>& board) {
-  output << "[";
-  for (auto piece = board.cbegin(); piece != board.cend(); piece++) {
-    if (piece != board.cbegin()) {
-      output << ", ";
-    }
-    output << "*";
-    if (*piece) {
-      output << **piece;
+         << ", table=[";
+  if (position.ply_) {
+    output << "top=*";
+    if (position.table_[position.ply_ - 1]) {
+      output << Board::toPiece(position.table_[position.ply_ - 1]);
     }
+    output << ", size=" << position.ply_;
+  }
+  output << "], blackToMove=" << position.blackToMove_
+         << ", state=" << position.state_ << ", memory=[";
+  if (position.ply_) {
+    output << "top=" << position.memory_[position.ply_ - 1]
+           << ", size=" << position.ply_;
   }
-  output << "]";
+  output << "], moveFactory=*" << *position.moveFactory_ << "]";
   return output;
 }
-std::ostream& operator<<(
-    std::ostream& output,
-    const std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>&
-        box) {
+std::ostream& operator<<(std::ostream& output,
+                         const std::array<int, 20>& box) {
   output << "{";
-  for (auto entry = box.cbegin(); entry != box.cend(); entry++) {
-    if (entry != box.cbegin()) {
-      output << ", ";
-    }
-    output << entry->first << "=[";
-    for (auto section = entry->second.cbegin(); section != entry->second.cend();
-         section++) {
-      if (section != entry->second.cbegin()) {
+  bool first = true;
+  for (unsigned char code = 0; code < 20; code++) {
+    if (box[code]) {
+      if (!first) {
         output << ", ";
       }
-      output << section->first << "=[";
-      for (auto piece = section->second.cbegin();
-           piece != section->second.cend(); piece++) {
-        if (piece != section->second.cbegin()) {
-          output << ", ";
-        }
-        output << "*";
-        if (*piece) {
-          output << **piece;
-        }
-      }
-      output << "]";
+      output << Board::toPiece(code) << "=" << box[code];
+      first = false;
     }
-    output << "]";
   }
   output << "}";
   return output;
 }
 std::ostream& operator<<(std::ostream& output,
-                         const std::stack<std::unique_ptr<Piece>>& table) {
-  output << "[";
-  if (!table.empty()) {
-    output << "top=*";
-    if (table.top()) {
-      output << *table.top();
-    }
-    output << ", size=" << table.size();
-  }
-  output << "]";
-  return output;
-}
-std::ostream& operator<<(
-    std::ostream& output,
-    const std::pair<std::set<int>, std::shared_ptr<int>>& state) {
+                         const std::pair<int, int>& state) {
   output << "([";
-  for (auto square = state.first.cbegin(); square != state.first.cend();
-       square++) {
-    if (square != state.first.cbegin()) {
-      output << ", ";
+  bool first = true;
+  for (int square = 0; square < 128; square++) {
+    if (state.first & Board::toCastling(square)) {
+      if (!first) {
+        output << ", ";
+      }
+      output << square;
+      first = false;
     }
-    output << *square;
   }
   output << "], *";
-  if (state.second) {
-    output << *state.second;
+  if (state.second >= 0) {
+    output << state.second;
   }
   output << ")";
   return output;
 }
-std::ostream& operator<<(
-    std::ostream& output,
-    const std::stack<std::pair<std::set<int>, std::shared_ptr<int>>>& memory) {
-  output << "[";
-  if (!memory.empty()) {
-    output << "top=" << memory.top() << ", size=" << memory.size();
-  }
-  output << "]";
-  return output;
-}
 
 }  // namespace moderato
@@ -24,42 +24,71 @@
 
 #pragma once
 
-#include <stack>
+#include <array>
+#include <deque>
 
+#include "Move.h"
 #include "MoveFactory.h"
 
 namespace moderato {
 
+class LegalMoveCounter;
+
 class Position {
-  std::array<std::unique_ptr<Piece>, 128> board_;
-  std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>> box_;
-  std::stack<std::unique_ptr<Piece>> table_;
+ public:
+  enum { MAX_PLY = 256 };
+
+ private:
+  Board board_;
+  std::array<int, 20> box_;
+  std::array<unsigned char, MAX_PLY> table_;
   bool blackToMove_ = false;
-  std::pair<std::set<int>, std::shared_ptr<int>> state_;
-  std::stack<std::pair<std::set<int>, std::shared_ptr<int>>> memory_;
+  std::pair<int, int> state_;
+  std::array<std::pair<int, int>, MAX_PLY> memory_;
+  std::array<int, MAX_PLY + 1> checks_;
+  int ply_ = 0;
   std::unique_ptr<MoveFactory> moveFactory_;
+  std::uint64_t stateKey_;
+  std::deque<MoveList> moves_;
+  bool isLocal(const Move& move, int royal,
+               const std::array<bool, 128>& lines) const;
+  bool generateMoves(LegalMoveCounter& counter, int royal, bool royalMoves);
 
  public:
-  Position(
-      std::array<std::unique_ptr<Piece>, 128> board,
-      std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>> box,
-      std::stack<std::unique_ptr<Piece>> table, bool blackToMove,
-      std::pair<std::set<int>, std::shared_ptr<int>> state,
-      std::stack<std::pair<std::set<int>, std::shared_ptr<int>>> memory,
-      std::unique_ptr<MoveFactory> moveFactory);
+  Position(Board board, std::array<int, 20> box, bool blackToMove,
+           std::pair<int, int> state, std::unique_ptr<MoveFactory> moveFactory);
+  Position(const Position& position);
+  Position(Position&& position) = default;
 
-  std::array<std::unique_ptr<Piece>, 128>& getBoard();
-  std::map<bool, std::map<int, std::deque<std::unique_ptr<Piece>>>>& getBox();
-  std::stack<std::unique_ptr<Piece>>& getTable();
+  Board& getBoard();
+  std::array<int, 20>& getBox();
+  std::array<unsigned char, MAX_PLY>& getTable();
   bool& isBlackToMove();
-  std::pair<std::set<int>, std::shared_ptr<int>>& getState();
-  std::stack<std::pair<std::set<int>, std::shared_ptr<int>>>& getMemory();
+  std::pair<int, int>& getState();
+  std::array<std::pair<int, int>, MAX_PLY>& getMemory();
+  std::array<int, MAX_PLY + 1>& getChecks();
+  int& getPly();
+  MoveList& getMoves(int ply);
+  std::uint64_t& getStateKey();
+  const MoveFactory& getMoveFactory() const;
+  std::uint64_t getKey() const;
+  std::uint64_t computeKey() const;
 
-  bool isLegal(std::vector<std::unique_ptr<Move>>& pseudoLegalMoves);
   bool isLegal();
+  bool isAttacked(int square, bool black);
+  // Lists returned here belong to the current ply and are overwritten by the
+  // next generation at that ply; countLegalMoves and hasLegalMove keep them.
+  MoveList& generateMoves();
+  MoveList& generateLegalMoves();
+  int countLegalMoves(int limit);
+  bool hasLegalMove();
+  bool generateMoves(MoveList& pseudoLegalMoves, int stage);
+  MoveList& generateChecks();
+  bool generateChecks(MoveList& pseudoLegalMoves, int stage);
   int isCheck();
-  bool isTerminal(const std::vector<std::unique_ptr<Move>>& pseudoLegalMoves);
+  bool isTerminal(const MoveList& pseudoLegalMoves);
 
+  friend class LegalMoveCounter;
   friend std::ostream& operator<<(std::ostream& output,
                                   const Position& position);
 };
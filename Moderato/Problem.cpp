@@ -58,16 +58,14 @@ void solve(const Task& task) {
 std::ostream& logger(std::ostream& output) {
   std::time_t calendarTime =
       std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+  std::tm localTime;
 #if _MSC_VER
-#pragma warning(push)
-#pragma warning(disable : 4996)
+  bool converted = !localtime_s(&localTime, &calendarTime);
+#else
+  bool converted = localtime_r(&calendarTime, &localTime);
 #endif
-  std::tm* localTime = std::localtime(&calendarTime);
-#if _MSC_VER
-#pragma warning(pop)
-#endif
-  if (localTime) {
-    output << std::put_time(localTime, "Moderato@%c ");
+  if (converted) {
+    output << std::put_time(&localTime, "Moderato@%c ");
   }
   return output;
 }
@@ -91,7 +89,10 @@ std::ostream& operator<<(std::ostream& output,
          << ", variations=" << analysisOptions.variations
          << ", threats=" << analysisOptions.threats
          << ", shortVariations=" << analysisOptions.shortVariations
-         << ", tempoTries=" << analysisOptions.tempoTries << "]";
+         << ", tempoTries=" << analysisOptions.tempoTries
+         << ", hashSize=" << analysisOptions.hashSize
+         << ", hashFile=\"" << analysisOptions.hashFile
+         << "\", nThreads=" << analysisOptions.nThreads << "]";
   return output;
 }
 
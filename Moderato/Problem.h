@@ -25,6 +25,7 @@
 #pragma once
 
 #include <istream>
+#include <string>
 
 #include "Position.h"
 
@@ -37,6 +38,9 @@ struct AnalysisOptions {
   bool threats = false;
   bool shortVariations = false;
   bool tempoTries = false;
+  int hashSize = 16;
+  std::string hashFile;
+  int nThreads = 1;
 };
 std::ostream& operator<<(std::ostream& output,
                          const AnalysisOptions& analysisOptions);
@@ -25,24 +25,58 @@
 #include "ProblemTypes.h"
 
 #include <algorithm>
+#include <atomic>
+#include <climits>
+#include <exception>
 #include <iostream>
 #include <sstream>
+#include <thread>
 
 #include "Move.h"
 
 namespace moderato {
 
+namespace {
+
+int toBound(int min, int depth) {
+  if (min == 0) {
+    return depth;
+  }
+  if (min > 0) {
+    return min;
+  }
+  return 1;
+}
+
+}  // namespace
+
 HelpProblem::HelpProblem(bool halfMove) : halfMove_(halfMove) {}
 
 MateProblem::MateProblem(bool stalemate) : stalemate_(stalemate) {}
 
+BattlePlay::~BattlePlay() {}
+
 void BattlePlay::solve(Position& position, bool stalemate, int nMoves,
                        bool includeSetPlay, int includeTries,
                        bool includeVariations, bool includeThreats,
                        bool includeShortVariations, int translate,
                        bool logMoves) {
-  std::vector<std::unique_ptr<Move>> pseudoLegalMoves;
-  bool includeActualPlay = position.isLegal(pseudoLegalMoves);
+  bool includeActualPlay = position.isLegal();
+  if (includeActualPlay) {
+    for (int depth = 1; depth < nMoves; depth++) {
+      int score = searchMax(
+          position, stalemate, depth,
+          MoveGenerator(position, &moveOrdering_, false, false), 1);
+      if (logMoves) {
+        logger(std::clog) << "depth=" << depth << " score=" << score
+                          << std::endl;
+      }
+      if (score > 0) {
+        break;
+      }
+    }
+  }
+  MoveList& pseudoLegalMoves = position.generateMoves();
   if (includeActualPlay || includeSetPlay) {
     std::vector<
         std::pair<std::pair<Play, std::string>,
@@ -64,7 +98,7 @@ void BattlePlay::solve(Position& position, bool stalemate, int nMoves,
 }
 void BattlePlay::analyseMax(
     Position& position, bool stalemate, int depth,
-    const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMax,
+    const MoveList& pseudoLegalMovesMax,
     std::vector<
         std::pair<std::pair<Play, std::string>,
                   std::vector<std::deque<std::pair<Play, std::string>>>>>&
@@ -73,10 +107,14 @@ void BattlePlay::analyseMax(
     bool includeShortVariations, bool includeSetPlay, int includeTries,
     bool includeActualPlay, bool markKeys, bool logMoves) {
   if (includeSetPlay && !(depth == getTerminalDepth())) {
-    std::unique_ptr<Move> move = std::make_unique<NullMove>();
-    std::vector<std::unique_ptr<Move>> pseudoLegalMovesMin;
-    if (move->make(position, pseudoLegalMovesMin)) {
-      int score = searchMin(position, stalemate, depth, pseudoLegalMovesMin, 0);
+    NullMove move;
+    if (move.make(position)) {
+      MoveList& pseudoLegalMovesMin = position.generateMoves();
+      MoveList orderedMovesMin = pseudoLegalMovesMin;
+      moveOrdering_.sort(position, orderedMovesMin.begin(),
+                         orderedMovesMin.end(), true);
+      int score = searchMin(position, stalemate, depth,
+                            MoveGenerator(orderedMovesMin), 0);
       std::vector<
           std::pair<std::pair<Play, std::string>,
                     std::vector<std::deque<std::pair<Play, std::string>>>>>
@@ -93,79 +131,142 @@ void BattlePlay::analyseMax(
       branches.push_back({{Play::SET, "null"}, toFlattened(variations)});
       if (logMoves) {
         if (score >= 0) {
-          logger(std::clog) << "depth=" << depth << " move=*" << *move
+          logger(std::clog) << "depth=" << depth << " move=*" << move
                             << " score=" << score << std::endl;
         } else {
-          logger(std::clog) << "depth=" << depth << " move=*" << *move
+          logger(std::clog) << "depth=" << depth << " move=*" << move
                             << " score<0" << std::endl;
         }
       }
     } else {
       std::cout << "Illegal position in set play." << std::endl;
     }
-    move->unmake(position);
+    move.unmake(position);
   }
   if (includeActualPlay) {
-    for (const std::unique_ptr<Move>& move : pseudoLegalMovesMax) {
-      std::vector<std::unique_ptr<Move>> pseudoLegalMovesMin;
-      std::ostringstream lanBuilder;
-      if (move->make(position, pseudoLegalMovesMin, lanBuilder, translate)) {
-        int score = searchMin(position, stalemate, depth, pseudoLegalMovesMin,
-                              includeTries);
-        if (score > 0) {
-          if (includeVariations && !(depth == getTerminalDepth())) {
-            std::vector<std::pair<
-                std::pair<Play, std::string>,
-                std::vector<std::deque<std::pair<Play, std::string>>>>>
-                variations;
-            analyseMin(position, stalemate, depth - score + 1,
-                       pseudoLegalMovesMin, variations, translate, true,
-                       includeThreats, includeShortVariations, false);
-            postWrite(position, pseudoLegalMovesMin, lanBuilder);
-            if (markKeys) {
-              branches.push_back(
-                  {{Play::KEY, lanBuilder.str()}, toFlattened(variations)});
-            } else {
-              branches.push_back({{Play::CONTINUATION, lanBuilder.str()},
-                                  toFlattened(variations)});
-            }
-          } else {
-            postWrite(position, pseudoLegalMovesMin, lanBuilder);
-            if (markKeys) {
-              branches.push_back({{Play::KEY, lanBuilder.str()}, {}});
-            } else {
-              branches.push_back({{Play::CONTINUATION, lanBuilder.str()}, {}});
+    int nThreads = std::min(nThreads_, pseudoLegalMovesMax.size());
+    if (markKeys && nThreads > 1) {
+      std::vector<std::vector<
+          std::pair<std::pair<Play, std::string>,
+                    std::vector<std::deque<std::pair<Play, std::string>>>>>>
+          moveBranches(pseudoLegalMovesMax.size());
+      std::vector<std::string> moveLogs(pseudoLegalMovesMax.size());
+      std::atomic<int> next(0);
+      std::vector<std::exception_ptr> exceptions(nThreads);
+      std::vector<std::thread> threads;
+      for (int thread = 0; thread < nThreads; thread++) {
+        threads.emplace_back([&, thread]() {
+          try {
+            std::unique_ptr<BattlePlay> battlePlay = clone(position);
+            Position& clonedPosition = battlePlay->position_;
+            int index;
+            while ((index = next++) < pseudoLegalMovesMax.size()) {
+              std::ostringstream log;
+              battlePlay->analyseMove(
+                  clonedPosition, stalemate, depth,
+                  pseudoLegalMovesMax.begin()[index], moveBranches[index],
+                  translate, includeVariations, includeThreats,
+                  includeShortVariations, includeTries, markKeys, logMoves,
+                  log);
+              moveLogs[index] = log.str();
             }
+          } catch (...) {
+            exceptions[thread] = std::current_exception();
+            next = pseudoLegalMovesMax.size();
           }
-        } else if (score >= -includeTries) {
-          std::vector<
-              std::pair<std::pair<Play, std::string>,
-                        std::vector<std::deque<std::pair<Play, std::string>>>>>
-              variations;
-          analyseMin(position, stalemate, depth, pseudoLegalMovesMin,
-                     variations, translate, includeVariations, includeThreats,
-                     includeShortVariations, false);
-          postWrite(position, pseudoLegalMovesMin, lanBuilder);
+        });
+      }
+      for (std::thread& thread : threads) {
+        thread.join();
+      }
+      for (const std::exception_ptr& exception : exceptions) {
+        if (exception) {
+          std::rethrow_exception(exception);
+        }
+      }
+      for (int index = 0; index < pseudoLegalMovesMax.size(); index++) {
+        branches.insert(branches.end(), moveBranches[index].begin(),
+                        moveBranches[index].end());
+        std::clog << moveLogs[index];
+      }
+    } else {
+      for (const Move& move : pseudoLegalMovesMax) {
+        analyseMove(position, stalemate, depth, move, branches, translate,
+                    includeVariations, includeThreats, includeShortVariations,
+                    includeTries, markKeys, logMoves, std::clog);
+      }
+    }
+  }
+}
+void BattlePlay::analyseMove(
+    Position& position, bool stalemate, int depth, const Move& move,
+    std::vector<
+        std::pair<std::pair<Play, std::string>,
+                  std::vector<std::deque<std::pair<Play, std::string>>>>>&
+        branches,
+    int translate, bool includeVariations, bool includeThreats,
+    bool includeShortVariations, int includeTries, bool markKeys,
+    bool logMoves, std::ostream& log) {
+  std::ostringstream lanBuilder;
+  if (move.make(position, lanBuilder, translate)) {
+    MoveList& pseudoLegalMovesMin = position.generateMoves();
+    MoveList orderedMovesMin = pseudoLegalMovesMin;
+    moveOrdering_.sort(position, orderedMovesMin.begin(), orderedMovesMin.end(),
+                       true);
+    int score = searchMin(position, stalemate, depth,
+                          MoveGenerator(orderedMovesMin), includeTries);
+    if (score > 0) {
+      if (includeVariations && !(depth == getTerminalDepth())) {
+        std::vector<
+            std::pair<std::pair<Play, std::string>,
+                      std::vector<std::deque<std::pair<Play, std::string>>>>>
+            variations;
+        analyseMin(position, stalemate, depth - score + 1, pseudoLegalMovesMin,
+                   variations, translate, true, includeThreats,
+                   includeShortVariations, false);
+        postWrite(position, pseudoLegalMovesMin, lanBuilder);
+        if (markKeys) {
           branches.push_back(
-              {{Play::TRY, lanBuilder.str()}, toFlattened(variations)});
+              {{Play::KEY, lanBuilder.str()}, toFlattened(variations)});
+        } else {
+          branches.push_back({{Play::CONTINUATION, lanBuilder.str()},
+                              toFlattened(variations)});
         }
-        if (logMoves) {
-          if (score >= -includeTries) {
-            logger(std::clog) << "depth=" << depth << " move=*" << *move
-                              << " score=" << score << std::endl;
-          } else {
-            logger(std::clog) << "depth=" << depth << " move=*" << *move
-                              << " score<" << -includeTries << std::endl;
-          }
+      } else {
+        postWrite(position, pseudoLegalMovesMin, lanBuilder);
+        if (markKeys) {
+          branches.push_back({{Play::KEY, lanBuilder.str()}, {}});
+        } else {
+          branches.push_back({{Play::CONTINUATION, lanBuilder.str()}, {}});
         }
       }
-      move->unmake(position);
+    } else if (score >= -includeTries) {
+      std::vector<
+          std::pair<std::pair<Play, std::string>,
+                    std::vector<std::deque<std::pair<Play, std::string>>>>>
+          variations;
+      analyseMin(position, stalemate, depth, pseudoLegalMovesMin, variations,
+                 translate, includeVariations, includeThreats,
+                 includeShortVariations, false);
+      postWrite(position, pseudoLegalMovesMin, lanBuilder);
+      branches.push_back(
+          {{Play::TRY, lanBuilder.str()}, toFlattened(variations)});
+    }
+    if (logMoves) {
+      if (score >= -includeTries) {
+        logger(log) << "depth=" << depth << " move=*" << move
+                    << " score=" << score << std::endl;
+      } else {
+        logger(log) << "depth=" << depth << " move=*" << move << " score<"
+                    << -includeTries << std::endl;
+      }
     }
   }
+  move.unmake(position);
 }
 void BattlePlay::analyseMin(
     Position& position, bool stalemate, int depth,
-    const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMin,
+    const MoveList& pseudoLegalMovesMin,
     std::vector<
         std::pair<std::pair<Play, std::string>,
                   std::vector<std::deque<std::pair<Play, std::string>>>>>&
@@ -173,14 +274,14 @@ void BattlePlay::analyseMin(
     int translate, bool includeVariations, bool includeThreats,
     bool includeShortVariations, bool includeSetPlay) {
   if (depth == getTerminalDepth()) {
-    for (const std::unique_ptr<Move>& move : pseudoLegalMovesMin) {
-      std::vector<std::unique_ptr<Move>> pseudoLegalMovesMax;
+    for (const Move& move : pseudoLegalMovesMin) {
       std::ostringstream lanBuilder;
-      if (move->make(position, pseudoLegalMovesMax, lanBuilder, translate)) {
+      if (move.make(position, lanBuilder, translate)) {
+        MoveList& pseudoLegalMovesMax = position.generateMoves();
         postWrite(position, pseudoLegalMovesMax, lanBuilder);
         branches.push_back({{Play::REFUTATION, lanBuilder.str()}, {}});
       }
-      move->unmake(position);
+      move.unmake(position);
     }
   } else {
     std::vector<
@@ -188,11 +289,11 @@ void BattlePlay::analyseMin(
                   std::vector<std::deque<std::pair<Play, std::string>>>>>
         threats;
     if (depth > 1 && includeVariations && includeThreats && !includeSetPlay) {
-      std::unique_ptr<Move> move = std::make_unique<NullMove>();
-      std::vector<std::unique_ptr<Move>> pseudoLegalMovesMax;
-      if (move->make(position, pseudoLegalMovesMax)) {
-        int score =
-            searchMax(position, stalemate, depth - 1, pseudoLegalMovesMax);
+      NullMove move;
+      if (move.make(position)) {
+        MoveList& pseudoLegalMovesMax = position.generateMoves();
+        int score = searchMax(position, stalemate, depth - 1,
+                              MoveGenerator(pseudoLegalMovesMax), depth - 1);
         if (score > 0) {
           analyseMax(position, stalemate, depth - score, pseudoLegalMovesMax,
                      threats, translate, true, true, includeShortVariations,
@@ -202,14 +303,14 @@ void BattlePlay::analyseMin(
           branches.push_back({{Play::ZUGZWANG, "null"}, {}});
         }
       }
-      move->unmake(position);
+      move.unmake(position);
     }
-    for (const std::unique_ptr<Move>& move : pseudoLegalMovesMin) {
-      std::vector<std::unique_ptr<Move>> pseudoLegalMovesMax;
+    for (const Move& move : pseudoLegalMovesMin) {
       std::ostringstream lanBuilder;
-      if (move->make(position, pseudoLegalMovesMax, lanBuilder, translate)) {
-        int score =
-            searchMax(position, stalemate, depth - 1, pseudoLegalMovesMax);
+      if (move.make(position, lanBuilder, translate)) {
+        MoveList& pseudoLegalMovesMax = position.generateMoves();
+        int score = searchMax(position, stalemate, depth - 1,
+                              MoveGenerator(pseudoLegalMovesMax), depth - 1);
         if (score > 0) {
           if ((includeVariations || includeSetPlay) &&
               (score == 1 || includeShortVariations)) {
@@ -234,62 +335,101 @@ void BattlePlay::analyseMin(
           branches.push_back({{Play::REFUTATION, lanBuilder.str()}, {}});
         }
       }
-      move->unmake(position);
+      move.unmake(position);
     }
   }
 }
 
 Directmate::Directmate(Position position, bool stalemate, int nMoves)
     : Problem(std::move(position), nMoves), MateProblem(stalemate) {}
+Directmate::Directmate(const Directmate& directmate, Position position)
+    : Problem(std::move(position), directmate.nMoves_),
+      MateProblem(directmate.stalemate_),
+      BattlePlay(directmate) {}
 void Directmate::solve(const AnalysisOptions& analysisOptions,
                        const DisplayOptions& displayOptions) {
+  std::ostringstream fingerprint;
+  fingerprint << "Directmate[stalemate=" << stalemate_
+              << ", blackToMove=" << position_.isBlackToMove()
+              << ", moveFactory=" << position_.getMoveFactory() << "]";
+  transpositionTable_ = std::make_shared<TranspositionTable>(
+      analysisOptions.hashSize, analysisOptions.hashFile, fingerprint.str());
+  nThreads_ = analysisOptions.nThreads;
   BattlePlay::solve(position_, stalemate_, nMoves_, analysisOptions.setPlay,
                     analysisOptions.nRefutations, analysisOptions.variations,
                     analysisOptions.threats, analysisOptions.shortVariations,
                     displayOptions.outputLanguage,
                     displayOptions.internalProgress);
+  if (displayOptions.internalProgress) {
+    logger(std::clog) << "transpositionTable=" << *transpositionTable_
+                      << std::endl;
+  }
+  transpositionTable_.reset();
 }
-int Directmate::searchMax(
-    Position& position, bool stalemate, int depth,
-    const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMax) {
-  int max = INT_MIN;
-  for (const std::unique_ptr<Move>& move : pseudoLegalMovesMax) {
-    std::vector<std::unique_ptr<Move>> pseudoLegalMovesMin;
-    if (move->make(position, pseudoLegalMovesMin)) {
+int Directmate::searchMax(Position& position, bool stalemate, int depth,
+                          MoveGenerator pseudoLegalMovesMax, int bound) {
+  std::uint64_t key = position.getKey();
+  int max;
+  if (transpositionTable_->probe(key, depth, bound, max)) {
+    return max;
+  }
+  max = INT_MIN;
+  for (const Move& move : pseudoLegalMovesMax) {
+    if (move.make(position)) {
+      MoveGenerator pseudoLegalMovesMin(
+          position, depth == 1 ? nullptr : &moveOrdering_, true, false);
       int score = searchMin(position, stalemate, depth, pseudoLegalMovesMin, 0);
       if (score > max) {
         max = score;
       }
     }
-    move->unmake(position);
-    if (max == depth) {
+    move.unmake(position);
+    if (max >= bound) {
+      moveOrdering_.update(position, move, depth);
       break;
     }
   }
+  transpositionTable_->store(key, depth, max, max >= bound && max < depth);
   return max;
 }
-int Directmate::searchMin(
-    Position& position, bool stalemate, int depth,
-    const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMin,
-    int nRefutations) {
-  int min = 0;
+int Directmate::searchMin(Position& position, bool stalemate, int depth,
+                          MoveGenerator pseudoLegalMovesMin, int nRefutations) {
+  std::uint64_t key = position.getKey();
+  int min;
+  if (!nRefutations &&
+      transpositionTable_->probe(key, depth, INT_MAX, min)) {
+    return min;
+  }
+  min = 0;
   if (depth == 1) {
-    for (const std::unique_ptr<Move>& move : pseudoLegalMovesMin) {
-      if (move->make(position)) {
-        min--;
-      }
-      move->unmake(position);
-      if (min < -nRefutations) {
+    if (!nRefutations) {
+      if (position.hasLegalMove()) {
         min = INT_MIN;
-        break;
+      }
+    } else {
+      for (const Move& move : pseudoLegalMovesMin) {
+        bool refutes = move.make(position);
+        if (refutes) {
+          min--;
+        }
+        move.unmake(position);
+        if (refutes) {
+          moveOrdering_.refute(position, move);
+        }
+        if (min < -nRefutations) {
+          min = INT_MIN;
+          break;
+        }
       }
     }
   } else {
-    for (const std::unique_ptr<Move>& move : pseudoLegalMovesMin) {
-      std::vector<std::unique_ptr<Move>> pseudoLegalMovesMax;
-      if (move->make(position, pseudoLegalMovesMax)) {
-        int score =
-            searchMax(position, stalemate, depth - 1, pseudoLegalMovesMax);
+    for (const Move& move : pseudoLegalMovesMin) {
+      bool refutes = false;
+      if (move.make(position)) {
+        MoveGenerator pseudoLegalMovesMax(position, &moveOrdering_, false,
+                                          depth == 2 && !stalemate);
+        int score = searchMax(position, stalemate, depth - 1,
+                              pseudoLegalMovesMax, toBound(min, depth - 1));
         if (min == 0) {
           if (score < 0) {
             min = -1;
@@ -309,9 +449,14 @@ int Directmate::searchMin(
             min--;
           }
         }
+        refutes = score < 0;
+      }
+      move.unmake(position);
+      if (refutes) {
+        moveOrdering_.refute(position, move);
       }
-      move->unmake(position);
       if (min < -nRefutations) {
+        moveOrdering_.update(position, move, depth);
         min = INT_MIN;
         break;
       }
@@ -324,9 +469,15 @@ int Directmate::searchMin(
       min = INT_MIN;
     }
   }
+  if (!nRefutations) {
+    transpositionTable_->store(key, depth, min, false);
+  }
   return min;
 }
 int Directmate::getTerminalDepth() const { return 1; }
+std::unique_ptr<BattlePlay> Directmate::clone(const Position& position) const {
+  return std::unique_ptr<BattlePlay>(new Directmate(*this, position));
+}
 void Directmate::write(std::ostream& output) const {
   output << "Directmate[position=" << position_ << ", stalemate=" << stalemate_
          << ", nMoves=" << nMoves_ << "]";
@@ -334,32 +485,46 @@ void Directmate::write(std::ostream& output) const {
 
 Selfmate::Selfmate(Position position, bool stalemate, int nMoves)
     : Problem(std::move(position), nMoves), MateProblem(stalemate) {}
+Selfmate::Selfmate(const Selfmate& selfmate, Position position)
+    : Problem(std::move(position), selfmate.nMoves_),
+      MateProblem(selfmate.stalemate_),
+      BattlePlay(selfmate) {}
 void Selfmate::solve(const AnalysisOptions& analysisOptions,
                      const DisplayOptions& displayOptions) {
+  std::ostringstream fingerprint;
+  fingerprint << "Selfmate[stalemate=" << stalemate_
+              << ", blackToMove=" << position_.isBlackToMove()
+              << ", moveFactory=" << position_.getMoveFactory() << "]";
+  transpositionTable_ = std::make_shared<TranspositionTable>(
+      analysisOptions.hashSize, analysisOptions.hashFile, fingerprint.str());
+  nThreads_ = analysisOptions.nThreads;
   BattlePlay::solve(position_, stalemate_, nMoves_, analysisOptions.setPlay,
                     analysisOptions.nRefutations, analysisOptions.variations,
                     analysisOptions.threats, analysisOptions.shortVariations,
                     displayOptions.outputLanguage,
                     displayOptions.internalProgress);
+  if (displayOptions.internalProgress) {
+    logger(std::clog) << "transpositionTable=" << *transpositionTable_
+                      << std::endl;
+  }
+  transpositionTable_.reset();
 }
-int Selfmate::searchMax(
-    Position& position, bool stalemate, int depth,
-    const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMax) {
-  int max = 0;
+int Selfmate::searchMax(Position& position, bool stalemate, int depth,
+                        MoveGenerator pseudoLegalMovesMax, int bound) {
+  std::uint64_t key = position.getKey();
+  int max;
+  if (transpositionTable_->probe(key, depth, bound, max)) {
+    return max;
+  }
+  max = 0;
   if (depth == 0) {
-    for (const std::unique_ptr<Move>& move : pseudoLegalMovesMax) {
-      if (move->make(position)) {
-        max = INT_MIN;
-      }
-      move->unmake(position);
-      if (max < 0) {
-        break;
-      }
+    if (position.hasLegalMove()) {
+      max = INT_MIN;
     }
   } else {
-    for (const std::unique_ptr<Move>& move : pseudoLegalMovesMax) {
-      std::vector<std::unique_ptr<Move>> pseudoLegalMovesMin;
-      if (move->make(position, pseudoLegalMovesMin)) {
+    for (const Move& move : pseudoLegalMovesMax) {
+      if (move.make(position)) {
+        MoveGenerator pseudoLegalMovesMin(position, false);
         int score =
             searchMin(position, stalemate, depth, pseudoLegalMovesMin, 0);
         if (max == 0) {
@@ -370,8 +535,9 @@ int Selfmate::searchMax(
           }
         }
       }
-      move->unmake(position);
-      if (max == depth) {
+      move.unmake(position);
+      if (max >= bound) {
+        moveOrdering_.update(position, move, depth);
         break;
       }
     }
@@ -383,18 +549,30 @@ int Selfmate::searchMax(
       max = INT_MIN;
     }
   }
+  transpositionTable_->store(key, depth, max, max >= bound && max < depth);
   return max;
 }
-int Selfmate::searchMin(
-    Position& position, bool stalemate, int depth,
-    const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMin,
-    int nRefutations) {
-  int min = 0;
-  for (const std::unique_ptr<Move>& move : pseudoLegalMovesMin) {
-    std::vector<std::unique_ptr<Move>> pseudoLegalMovesMax;
-    if (move->make(position, pseudoLegalMovesMax)) {
-      int score =
-          searchMax(position, stalemate, depth - 1, pseudoLegalMovesMax);
+int Selfmate::searchMin(Position& position, bool stalemate, int depth,
+                        MoveGenerator pseudoLegalMovesMin, int nRefutations) {
+  std::uint64_t key = position.getKey();
+  int min;
+  if (!nRefutations &&
+      transpositionTable_->probe(key, depth, INT_MAX, min)) {
+    return min;
+  }
+  min = 0;
+  for (const Move& move : pseudoLegalMovesMin) {
+    bool refutes = false;
+    if (move.make(position)) {
+      int score;
+      if (depth == 1 && !evaluateTerminalNode(position, stalemate)) {
+        score = INT_MIN;
+      } else {
+        MoveGenerator pseudoLegalMovesMax(
+            position, depth == 1 ? nullptr : &moveOrdering_, false, false);
+        score = searchMax(position, stalemate, depth - 1, pseudoLegalMovesMax,
+                          toBound(min, depth - 1));
+      }
       if (min == 0) {
         if (score < 0) {
           min = -1;
@@ -414,9 +592,14 @@ int Selfmate::searchMin(
           min--;
         }
       }
+      refutes = score < 0;
+    }
+    move.unmake(position);
+    if (refutes) {
+      moveOrdering_.refute(position, move);
     }
-    move->unmake(position);
     if (min < -nRefutations) {
+      moveOrdering_.update(position, move, depth);
       min = INT_MIN;
       break;
     }
@@ -424,9 +607,15 @@ int Selfmate::searchMin(
   if (min == 0) {
     min = INT_MIN;
   }
+  if (!nRefutations) {
+    transpositionTable_->store(key, depth, min, false);
+  }
   return min;
 }
 int Selfmate::getTerminalDepth() const { return 0; }
+std::unique_ptr<BattlePlay> Selfmate::clone(const Position& position) const {
+  return std::unique_ptr<BattlePlay>(new Selfmate(*this, position));
+}
 void Selfmate::write(std::ostream& output) const {
   output << "Selfmate[position=" << position_ << ", stalemate=" << stalemate_
          << ", nMoves=" << nMoves_ << "]";
@@ -438,15 +627,28 @@ Helpmate::Helpmate(Position position, bool stalemate, int nMoves, bool halfMove)
       MateProblem(stalemate) {}
 void Helpmate::solve(const AnalysisOptions& analysisOptions,
                      const DisplayOptions& displayOptions) {
+  std::ostringstream fingerprint;
+  fingerprint << "Helpmate[stalemate=" << stalemate_
+              << ", blackToMove=" << position_.isBlackToMove()
+              << ", halfMove=" << halfMove_
+              << ", tempoTries=" << analysisOptions.tempoTries
+              << ", moveFactory=" << position_.getMoveFactory() << "]";
+  transpositionTable_ = std::make_unique<TranspositionTable>(
+      analysisOptions.hashSize, analysisOptions.hashFile, fingerprint.str());
   solve(position_, stalemate_, nMoves_, halfMove_, analysisOptions.setPlay,
         analysisOptions.tempoTries, displayOptions.outputLanguage,
         displayOptions.internalProgress);
+  if (displayOptions.internalProgress) {
+    logger(std::clog) << "transpositionTable=" << *transpositionTable_
+                      << std::endl;
+  }
+  transpositionTable_.reset();
 }
 void Helpmate::solve(Position& position, bool stalemate, int nMoves,
                      bool halfMove, bool includeSetPlay, bool includeTempoTries,
                      int translate, bool logMoves) {
-  std::vector<std::unique_ptr<Move>> pseudoLegalMoves;
-  bool includeActualPlay = position.isLegal(pseudoLegalMoves);
+  bool includeActualPlay = position.isLegal();
+  MoveList& pseudoLegalMoves = position.generateMoves();
   if (includeActualPlay || includeSetPlay) {
     std::vector<
         std::pair<std::pair<Play, std::string>,
@@ -473,18 +675,24 @@ void Helpmate::solve(Position& position, bool stalemate, int nMoves,
 }
 int Helpmate::analyseMax(
     Position& position, bool stalemate, int depth,
-    const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMax,
+    const MoveList& pseudoLegalMovesMax,
     std::vector<
         std::pair<std::pair<Play, std::string>,
                   std::vector<std::deque<std::pair<Play, std::string>>>>>&
         branchesMax,
     int translate, bool includeTempoTries, bool includeSetPlay,
     bool includeActualPlay, bool logMoves) {
+  std::uint64_t key = position.getKey();
+  long score;
+  if (includeActualPlay && !includeSetPlay &&
+      transpositionTable_->probeExact(key, depth, score) && score == 0) {
+    return 0;
+  }
   int max = 0;
   if (includeSetPlay || includeTempoTries) {
-    std::unique_ptr<Move> move = std::make_unique<NullMove>();
-    std::vector<std::unique_ptr<Move>> pseudoLegalMovesMin;
-    if (move->make(position, pseudoLegalMovesMin)) {
+    NullMove move;
+    if (move.make(position)) {
+      MoveList& pseudoLegalMovesMin = position.generateMoves();
       std::vector<
           std::pair<std::pair<Play, std::string>,
                     std::vector<std::deque<std::pair<Play, std::string>>>>>
@@ -502,7 +710,7 @@ int Helpmate::analyseMax(
         }
       }
       if (logMoves) {
-        logger(std::clog) << "depth=" << depth << " move=*" << *move
+        logger(std::clog) << "depth=" << depth << " move=*" << move
                           << " branches.size()=" << branchesMax.size()
                           << std::endl;
       }
@@ -511,13 +719,13 @@ int Helpmate::analyseMax(
         std::cout << "Illegal position in set play." << std::endl;
       }
     }
-    move->unmake(position);
+    move.unmake(position);
   }
   if (includeActualPlay) {
-    for (const std::unique_ptr<Move>& move : pseudoLegalMovesMax) {
-      std::vector<std::unique_ptr<Move>> pseudoLegalMovesMin;
+    for (const Move& move : pseudoLegalMovesMax) {
       std::ostringstream lanBuilder;
-      if (move->make(position, pseudoLegalMovesMin, lanBuilder, translate)) {
+      if (move.make(position, lanBuilder, translate)) {
+        MoveList& pseudoLegalMovesMin = position.generateMoves();
         std::vector<
             std::pair<std::pair<Play, std::string>,
                       std::vector<std::deque<std::pair<Play, std::string>>>>>
@@ -532,41 +740,44 @@ int Helpmate::analyseMax(
         }
         if (logMoves) {
           logger(std::clog)
-              << "depth=" << depth << " move=*" << *move
+              << "depth=" << depth << " move=*" << move
               << " branches.size()=" << branchesMax.size() << std::endl;
         }
       }
-      move->unmake(position);
+      move.unmake(position);
     }
   }
+  if (includeActualPlay && !includeSetPlay) {
+    transpositionTable_->storeExact(key, depth, max);
+  }
   return max;
 }
 int Helpmate::analyseMin(
     Position& position, bool stalemate, int depth,
-    const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMin,
+    const MoveList& pseudoLegalMovesMin,
     std::vector<
         std::pair<std::pair<Play, std::string>,
                   std::vector<std::deque<std::pair<Play, std::string>>>>>&
         branchesMin,
     int translate, bool includeTempoTries, bool includeSetPlay,
     bool includeActualPlay, bool logMoves) {
+  std::uint64_t key = position.getKey();
+  long score;
+  if (includeActualPlay && !includeSetPlay &&
+      transpositionTable_->probeExact(key, depth, score) && score == 0) {
+    return 0;
+  }
   int min = 0;
   int nLegalMoves = 0;
   if (depth == 0) {
-    for (const std::unique_ptr<Move>& move : pseudoLegalMovesMin) {
-      if (move->make(position)) {
-        nLegalMoves++;
-      }
-      move->unmake(position);
-      if (nLegalMoves != 0) {
-        break;
-      }
-    }
+    nLegalMoves = position.countLegalMoves(1);
   } else {
     if (includeSetPlay || includeTempoTries) {
-      std::unique_ptr<Move> move = std::make_unique<NullMove>();
-      std::vector<std::unique_ptr<Move>> pseudoLegalMovesMax;
-      if (move->make(position, pseudoLegalMovesMax)) {
+      NullMove move;
+      if (move.make(position)) {
+        MoveList& pseudoLegalMovesMax = depth == 1 && !stalemate
+                                            ? position.generateChecks()
+                                            : position.generateMoves();
         std::vector<
             std::pair<std::pair<Play, std::string>,
                       std::vector<std::deque<std::pair<Play, std::string>>>>>
@@ -585,7 +796,7 @@ int Helpmate::analyseMin(
         }
         if (logMoves) {
           logger(std::clog)
-              << "depth=" << depth << " move=*" << *move
+              << "depth=" << depth << " move=*" << move
               << " branches.size()=" << branchesMin.size() << std::endl;
         }
       } else {
@@ -593,13 +804,15 @@ int Helpmate::analyseMin(
           std::cout << "Illegal position in set play." << std::endl;
         }
       }
-      move->unmake(position);
+      move.unmake(position);
     }
     if (includeActualPlay) {
-      for (const std::unique_ptr<Move>& move : pseudoLegalMovesMin) {
-        std::vector<std::unique_ptr<Move>> pseudoLegalMovesMax;
+      for (const Move& move : pseudoLegalMovesMin) {
         std::ostringstream lanBuilder;
-        if (move->make(position, pseudoLegalMovesMax, lanBuilder, translate)) {
+        if (move.make(position, lanBuilder, translate)) {
+          MoveList& pseudoLegalMovesMax = depth == 1 && !stalemate
+                                              ? position.generateChecks()
+                                              : position.generateMoves();
           nLegalMoves++;
           std::vector<
               std::pair<std::pair<Play, std::string>,
@@ -615,11 +828,11 @@ int Helpmate::analyseMin(
           }
           if (logMoves) {
             logger(std::clog)
-                << "depth=" << depth << " move=*" << *move
+                << "depth=" << depth << " move=*" << move
                 << " branches.size()=" << branchesMin.size() << std::endl;
           }
         }
-        move->unmake(position);
+        move.unmake(position);
       }
     }
   }
@@ -632,6 +845,9 @@ int Helpmate::analyseMin(
       }
     }
   }
+  if (includeActualPlay && !includeSetPlay) {
+    transpositionTable_->storeExact(key, depth, min);
+  }
   return min;
 }
 void Helpmate::write(std::ostream& output) const {
@@ -646,15 +862,16 @@ void MateSearch::solve(const AnalysisOptions& analysisOptions,
   solve(position_, nMoves_, displayOptions.outputLanguage);
 }
 void MateSearch::solve(Position& position, int nMoves, int translate) {
-  std::vector<std::unique_ptr<Move>> pseudoLegalMovesMax;
-  if (position.isLegal(pseudoLegalMovesMax)) {
+  if (position.isLegal()) {
+    MoveList& pseudoLegalMovesMax = position.generateMoves();
     std::vector<std::pair<std::string, std::string>> points;
-    for (const std::unique_ptr<Move>& move : pseudoLegalMovesMax) {
-      std::vector<std::unique_ptr<Move>> pseudoLegalMovesMin;
+    for (const Move& move : pseudoLegalMovesMax) {
       std::ostringstream lanBuilder;
-      if (move->make(position, pseudoLegalMovesMin, lanBuilder, translate)) {
+      if (move.make(position, lanBuilder, translate)) {
+        MoveList& pseudoLegalMovesMin = position.generateMoves();
         for (int depth = 1; depth <= nMoves; depth++) {
-          int score = searchMin(position, depth, pseudoLegalMovesMin);
+          int score = searchMin(position, depth,
+                                MoveGenerator(pseudoLegalMovesMin));
           if (score > 0) {
             postWrite(position, pseudoLegalMovesMin, lanBuilder);
             if (position.isBlackToMove()) {
@@ -668,50 +885,42 @@ void MateSearch::solve(Position& position, int nMoves, int translate) {
           }
         }
       }
-      move->unmake(position);
+      move.unmake(position);
     }
     std::cout << toOrderedAndFormatted(points) << std::endl;
   } else {
     std::cout << "Illegal position." << std::endl;
   }
 }
-int MateSearch::searchMax(
-    Position& position, int depth,
-    const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMax) {
+int MateSearch::searchMax(Position& position, int depth,
+                          MoveGenerator pseudoLegalMovesMax) {
   int max = -1;
-  for (const std::unique_ptr<Move>& move : pseudoLegalMovesMax) {
-    std::vector<std::unique_ptr<Move>> pseudoLegalMovesMin;
-    if (move->make(position, pseudoLegalMovesMin)) {
+  for (const Move& move : pseudoLegalMovesMax) {
+    if (move.make(position)) {
+      MoveGenerator pseudoLegalMovesMin(position, false);
       max = searchMin(position, depth, pseudoLegalMovesMin);
     }
-    move->unmake(position);
+    move.unmake(position);
     if (max > 0) {
       break;
     }
   }
   return max;
 }
-int MateSearch::searchMin(
-    Position& position, int depth,
-    const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMin) {
+int MateSearch::searchMin(Position& position, int depth,
+                          MoveGenerator pseudoLegalMovesMin) {
   int min = 0;
   if (depth == 1) {
-    for (const std::unique_ptr<Move>& move : pseudoLegalMovesMin) {
-      if (move->make(position)) {
-        min = -1;
-      }
-      move->unmake(position);
-      if (min < 0) {
-        break;
-      }
+    if (position.hasLegalMove()) {
+      min = -1;
     }
   } else {
-    for (const std::unique_ptr<Move>& move : pseudoLegalMovesMin) {
-      std::vector<std::unique_ptr<Move>> pseudoLegalMovesMax;
-      if (move->make(position, pseudoLegalMovesMax)) {
+    for (const Move& move : pseudoLegalMovesMin) {
+      if (move.make(position)) {
+        MoveGenerator pseudoLegalMovesMax(position, depth == 2);
         min = searchMax(position, depth - 1, pseudoLegalMovesMax);
       }
-      move->unmake(position);
+      move.unmake(position);
       if (min < 0) {
         break;
       }
@@ -735,36 +944,50 @@ Perft::Perft(Position position, int nMoves, bool halfMove)
     : Problem(std::move(position), nMoves), HelpProblem(halfMove) {}
 void Perft::solve(const AnalysisOptions& analysisOptions,
                   const DisplayOptions& displayOptions) {
+  std::ostringstream fingerprint;
+  fingerprint << "Perft[moveFactory=" << position_.getMoveFactory() << "]";
+  transpositionTable_ = std::make_unique<TranspositionTable>(
+      analysisOptions.hashSize, analysisOptions.hashFile, fingerprint.str());
   solve(position_, nMoves_, halfMove_);
+  if (displayOptions.internalProgress) {
+    logger(std::clog) << "transpositionTable=" << *transpositionTable_
+                      << std::endl;
+  }
+  transpositionTable_.reset();
 }
 void Perft::solve(Position& position, int nMoves, bool halfMove) {
-  std::vector<std::unique_ptr<Move>> pseudoLegalMoves;
-  if (position.isLegal(pseudoLegalMoves)) {
+  if (position.isLegal()) {
     long nNodes;
     if (halfMove) {
-      nNodes = analyse(position, nMoves * 2 + 1, pseudoLegalMoves);
+      nNodes = analyse(position, nMoves * 2 + 1);
     } else {
-      nNodes = analyse(position, nMoves * 2, pseudoLegalMoves);
+      nNodes = analyse(position, nMoves * 2);
     }
     std::cout << nNodes << std::endl;
   } else {
     std::cout << "Illegal position." << std::endl;
   }
 }
-long Perft::analyse(
-    Position& position, int depth,
-    const std::vector<std::unique_ptr<Move>>& pseudoLegalMoves) {
+long Perft::analyse(Position& position, int depth) {
   if (depth == 0) {
     return 1;
   }
-  long nNodes = 0;
-  for (const std::unique_ptr<Move>& move : pseudoLegalMoves) {
-    std::vector<std::unique_ptr<Move>> pseudoLegalMovesNext;
-    if (move->make(position, pseudoLegalMovesNext)) {
-      nNodes += analyse(position, depth - 1, pseudoLegalMovesNext);
-    }
-    move->unmake(position);
+  std::uint64_t key = position.getKey();
+  long nNodes;
+  if (depth > 1 && transpositionTable_->probeExact(key, depth, nNodes)) {
+    return nNodes;
+  }
+  MoveList& legalMoves = position.generateLegalMoves();
+  if (depth == 1) {
+    return legalMoves.size();
+  }
+  nNodes = 0;
+  for (const Move& move : legalMoves) {
+    move.make(position);
+    nNodes += analyse(position, depth - 1);
+    move.unmake(position);
   }
+  transpositionTable_->storeExact(key, depth, nNodes);
   return nNodes;
 }
 void Perft::write(std::ostream& output) const {
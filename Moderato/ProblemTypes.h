@@ -24,8 +24,11 @@
 
 #pragma once
 
+#include "MoveGenerator.h"
+#include "MoveOrdering.h"
 #include "Problem.h"
 #include "Solution.h"
+#include "TranspositionTable.h"
 
 namespace moderato {
 
@@ -41,10 +44,10 @@ class MateProblem : virtual public Problem {
   MateProblem(bool stalemate);
 };
 
-class BattlePlay {
+class BattlePlay : virtual public Problem {
   void analyseMax(
       Position& position, bool stalemate, int depth,
-      const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMax,
+      const MoveList& pseudoLegalMovesMax,
       std::vector<
           std::pair<std::pair<Play, std::string>,
                     std::vector<std::deque<std::pair<Play, std::string>>>>>&
@@ -52,39 +55,53 @@ class BattlePlay {
       int translate, bool includeVariations, bool includeThreats,
       bool includeShortVariations, bool includeSetPlay, int includeTries,
       bool includeActualPlay, bool markKeys, bool logMoves);
+  void analyseMove(
+      Position& position, bool stalemate, int depth, const Move& move,
+      std::vector<
+          std::pair<std::pair<Play, std::string>,
+                    std::vector<std::deque<std::pair<Play, std::string>>>>>&
+          branches,
+      int translate, bool includeVariations, bool includeThreats,
+      bool includeShortVariations, int includeTries, bool markKeys,
+      bool logMoves, std::ostream& log);
   void analyseMin(
       Position& position, bool stalemate, int depth,
-      const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMin,
+      const MoveList& pseudoLegalMovesMin,
       std::vector<
           std::pair<std::pair<Play, std::string>,
                     std::vector<std::deque<std::pair<Play, std::string>>>>>&
           branches,
       int translate, bool includeVariations, bool includeThreats,
       bool includeShortVariations, bool includeSetPlay);
-  virtual int searchMax(
-      Position& position, bool stalemate, int depth,
-      const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMax) = 0;
-  virtual int searchMin(
-      Position& position, bool stalemate, int depth,
-      const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMin,
-      int nRefutations) = 0;
+  virtual int searchMax(Position& position, bool stalemate, int depth,
+                        MoveGenerator pseudoLegalMovesMax, int bound) = 0;
+  virtual int searchMin(Position& position, bool stalemate, int depth,
+                        MoveGenerator pseudoLegalMovesMin,
+                        int nRefutations) = 0;
   virtual int getTerminalDepth() const = 0;
+  virtual std::unique_ptr<BattlePlay> clone(const Position& position) const = 0;
 
  protected:
+  std::shared_ptr<TranspositionTable> transpositionTable_;
+  MoveOrdering moveOrdering_;
+  int nThreads_ = 1;
   void solve(Position& position, bool stalemate, int nMoves,
              bool includeSetPlay, int includeTries, bool includeVariations,
              bool includeThreats, bool includeShortVariations, int translate,
              bool logMoves);
+
+ public:
+  virtual ~BattlePlay();
 };
 
 class Directmate : public MateProblem, BattlePlay {
-  int searchMax(
-      Position& position, bool stalemate, int depth,
-      const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMax) override;
+  int searchMax(Position& position, bool stalemate, int depth,
+                MoveGenerator pseudoLegalMovesMax, int bound) override;
   int searchMin(Position& position, bool stalemate, int depth,
-                const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMin,
-                int nRefutations) override;
+                MoveGenerator pseudoLegalMovesMin, int nRefutations) override;
   int getTerminalDepth() const override;
+  Directmate(const Directmate& directmate, Position position);
+  std::unique_ptr<BattlePlay> clone(const Position& position) const override;
   void write(std::ostream& output) const override;
 
  public:
@@ -94,13 +111,13 @@ class Directmate : public MateProblem, BattlePlay {
 };
 
 class Selfmate : public MateProblem, BattlePlay {
-  int searchMax(
-      Position& position, bool stalemate, int depth,
-      const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMax) override;
+  int searchMax(Position& position, bool stalemate, int depth,
+                MoveGenerator pseudoLegalMovesMax, int bound) override;
   int searchMin(Position& position, bool stalemate, int depth,
-                const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMin,
-                int nRefutations) override;
+                MoveGenerator pseudoLegalMovesMin, int nRefutations) override;
   int getTerminalDepth() const override;
+  Selfmate(const Selfmate& selfmate, Position position);
+  std::unique_ptr<BattlePlay> clone(const Position& position) const override;
   void write(std::ostream& output) const override;
 
  public:
@@ -110,12 +127,13 @@ class Selfmate : public MateProblem, BattlePlay {
 };
 
 class Helpmate : public HelpProblem, public MateProblem {
+  std::unique_ptr<TranspositionTable> transpositionTable_;
   void solve(Position& position, bool stalemate, int nMoves, bool halfMove,
              bool includeSetPlay, bool includeTempoTries, int translate,
              bool logMoves);
   int analyseMax(
       Position& position, bool stalemate, int depth,
-      const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMax,
+      const MoveList& pseudoLegalMovesMax,
       std::vector<
           std::pair<std::pair<Play, std::string>,
                     std::vector<std::deque<std::pair<Play, std::string>>>>>&
@@ -124,7 +142,7 @@ class Helpmate : public HelpProblem, public MateProblem {
       bool includeActualPlay, bool logMoves);
   int analyseMin(
       Position& position, bool stalemate, int depth,
-      const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMin,
+      const MoveList& pseudoLegalMovesMin,
       std::vector<
           std::pair<std::pair<Play, std::string>,
                     std::vector<std::deque<std::pair<Play, std::string>>>>>&
@@ -142,9 +160,9 @@ class Helpmate : public HelpProblem, public MateProblem {
 class MateSearch : public Problem {
   void solve(Position& position, int nMoves, int translate);
   int searchMax(Position& position, int depth,
-                const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMax);
+                MoveGenerator pseudoLegalMovesMax);
   int searchMin(Position& position, int depth,
-                const std::vector<std::unique_ptr<Move>>& pseudoLegalMovesMin);
+                MoveGenerator pseudoLegalMovesMin);
   void write(std::ostream& output) const override;
 
  public:
@@ -154,9 +172,9 @@ class MateSearch : public Problem {
 };
 
 class Perft : public HelpProblem {
+  std::unique_ptr<TranspositionTable> transpositionTable_;
   void solve(Position& position, int nMoves, bool halfMove);
-  long analyse(Position& position, int depth,
-               const std::vector<std::unique_ptr<Move>>& pseudoLegalMoves);
+  long analyse(Position& position, int depth);
   void write(std::ostream& output) const override;
 
  public:
@@ -0,0 +1,491 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024-2025 Ivan Denkovski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "SpecialisedMoveFactory.h"
+
+#include <climits>
+#include <type_traits>
+
+#include "MoveSinks.h"
+
+namespace moderato {
+
+namespace {
+
+const int kingLeaps[] = {-17, -16, -15, -1, 1, 15, 16, 17};
+const int knightLeaps[] = {-33, -31, -18, -14, 14, 18, 31, 33};
+const int orthogonalRides[] = {-16, -1, 1, 16};
+const int diagonalRides[] = {-17, -15, 15, 17};
+
+int findRider(const Board& board, int square, int direction) {
+  int origin = square - direction;
+  while (!(origin & 136)) {
+    if (board.at(origin)) {
+      return origin;
+    }
+    origin -= direction;
+  }
+  return -1;
+}
+
+}  // namespace
+
+template <class Conditions>
+template <class Sink>
+bool SpecialisedMoveFactory<Conditions>::generateLeaps(
+    const Board& board, int origin, bool black, const std::vector<int>& leaps,
+    Sink& sink, int stage) const {
+  for (int direction : leaps) {
+    int target = origin + direction;
+    if (!(target & 136)) {
+      unsigned char piece = board.at(target);
+      if (piece) {
+        if (stage & Piece::CAPTURES && Board::isBlack(piece) != black) {
+          if (!this->generateCapture(board, origin, target, sink.getMoves()) ||
+              !sink.flush()) {
+            return false;
+          }
+        }
+      } else if (stage & Piece::QUIET_MOVES) {
+        this->generateQuietMove(board, origin, target, sink.getMoves());
+        if (!sink.flush()) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+template <class Conditions>
+template <class Sink>
+bool SpecialisedMoveFactory<Conditions>::generateRides(
+    const Board& board, int origin, bool black, const std::vector<int>& rides,
+    Sink& sink, int stage) const {
+  for (int direction : rides) {
+    int distance = 1;
+    while (true) {
+      int target = origin + distance * direction;
+      if (!(target & 136)) {
+        unsigned char piece = board.at(target);
+        if (piece) {
+          if (stage & Piece::CAPTURES && Board::isBlack(piece) != black) {
+            if (!this->generateCapture(board, origin, target,
+                                       sink.getMoves()) ||
+                !sink.flush()) {
+              return false;
+            }
+          }
+          break;
+        } else {
+          if (stage & Piece::QUIET_MOVES) {
+            this->generateQuietMove(board, origin, target, sink.getMoves());
+            if (!sink.flush()) {
+              return false;
+            }
+          }
+          distance++;
+        }
+      } else {
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+template <class Conditions>
+template <class Sink>
+bool SpecialisedMoveFactory<Conditions>::generateHops(
+    const Board& board, int origin, bool black, const std::vector<int>& hops,
+    Sink& sink, int stage) const {
+  for (int direction : hops) {
+    int distance = 1;
+    while (true) {
+      int target = origin + distance * direction;
+      if (!(target & 136)) {
+        if (board.at(target)) {
+          target = origin + (distance + 1) * direction;
+          if (!(target & 136)) {
+            unsigned char piece = board.at(target);
+            if (piece) {
+              if (stage & Piece::CAPTURES && Board::isBlack(piece) != black) {
+                if (!this->generateCapture(board, origin, target,
+                                           sink.getMoves()) ||
+                    !sink.flush()) {
+                  return false;
+                }
+              }
+            } else if (stage & Piece::QUIET_MOVES) {
+              this->generateQuietMove(board, origin, target, sink.getMoves());
+              if (!sink.flush()) {
+                return false;
+              }
+            }
+          }
+          break;
+        } else {
+          distance++;
+        }
+      } else {
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+template <class Conditions>
+template <class Sink>
+bool SpecialisedMoveFactory<Conditions>::generatePawnMoves(
+    const Board& board, const std::array<int, 20>& box,
+    const std::pair<int, int>& state, int origin, bool black, Sink& sink,
+    int stage) const {
+  if (stage & Piece::CAPTURES) {
+    int directions[] = {black ? -17 : -15, black ? 15 : 17};
+    for (int direction : directions) {
+      int target = origin + direction;
+      if (!(target & 136)) {
+        unsigned char piece = board.at(target);
+        if (piece) {
+          if (Board::isBlack(piece) != black) {
+            if (origin % 16 == (black ? 1 : 6)) {
+              for (int type = Board::QUEEN; type <= Board::AMAZON; type++) {
+                if (box[Board::toCode(type, black)]) {
+                  if (!this->generatePromotionCapture(board, origin, target,
+                                                      black, type,
+                                                      sink.getMoves()) ||
+                      !sink.flush()) {
+                    return false;
+                  }
+                }
+              }
+            } else {
+              if (!this->generateCapture(board, origin, target,
+                                         sink.getMoves()) ||
+                  !sink.flush()) {
+                return false;
+              }
+            }
+          }
+        } else {
+          int enPassant = state.second;
+          if (target == enPassant) {
+            int stop = target + (black ? 1 : -1);
+            if (!this->generateEnPassant(board, origin, target, stop,
+                                         sink.getMoves()) ||
+                !sink.flush()) {
+              return false;
+            }
+          }
+        }
+      }
+    }
+  }
+  if (stage & Piece::QUIET_MOVES) {
+    int direction = black ? -1 : 1;
+    int target = origin + direction;
+    if (!(target & 136)) {
+      if (!board.at(target)) {
+        if (origin % 16 == (black ? 1 : 6)) {
+          for (int type = Board::QUEEN; type <= Board::AMAZON; type++) {
+            if (box[Board::toCode(type, black)]) {
+              this->generatePromotion(board, origin, target, black, type,
+                                      sink.getMoves());
+              if (!sink.flush()) {
+                return false;
+              }
+            }
+          }
+        } else {
+          this->generateQuietMove(board, origin, target, sink.getMoves());
+          if (!sink.flush()) {
+            return false;
+          }
+          if (origin % 16 == (black ? 6 : 1)) {
+            target = origin + 2 * direction;
+            if (!board.at(target)) {
+              int stop = origin + direction;
+              this->generateDoubleStep(board, origin, target, stop,
+                                       sink.getMoves());
+              if (!sink.flush()) {
+                return false;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+template <class Conditions>
+template <class Sink>
+bool SpecialisedMoveFactory<Conditions>::generateCastlings(
+    const Board& board, int castlings, int origin, Sink& sink) const {
+  for (int direction : {-16, 16}) {
+    int distance = 1;
+    while (true) {
+      int origin2 = origin + distance * direction;
+      if (!(origin2 & 136)) {
+        if (castlings & Board::toCastling(origin2)) {
+          int target = origin + 2 * direction;
+          int target2 = origin + direction;
+          if (direction > 0) {
+            this->generateShortCastling(board, origin, target, origin2, target2,
+                                        sink.getMoves());
+          } else {
+            this->generateLongCastling(board, origin, target, origin2, target2,
+                                       sink.getMoves());
+          }
+          if (!sink.flush()) {
+            return false;
+          }
+          break;
+        } else if (board.at(origin2)) {
+          break;
+        } else {
+          distance++;
+        }
+      } else {
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+template <class Conditions>
+bool SpecialisedMoveFactory<Conditions>::generateLeaps(
+    const Board& board, int origin, bool black, const std::vector<int>& leaps,
+    MoveList& moves, int stage) const {
+  MoveCollector collector(moves);
+  return generateLeaps(board, origin, black, leaps, collector, stage);
+}
+template <class Conditions>
+bool SpecialisedMoveFactory<Conditions>::generateLeaps(
+    const Board& board, int origin, bool black, const std::vector<int>& leaps,
+    LegalMoveCounter& counter) const {
+  return generateLeaps(board, origin, black, leaps, counter, Piece::ALL_MOVES);
+}
+template <class Conditions>
+bool SpecialisedMoveFactory<Conditions>::generateRides(
+    const Board& board, int origin, bool black, const std::vector<int>& rides,
+    MoveList& moves, int stage) const {
+  MoveCollector collector(moves);
+  return generateRides(board, origin, black, rides, collector, stage);
+}
+template <class Conditions>
+bool SpecialisedMoveFactory<Conditions>::generateRides(
+    const Board& board, int origin, bool black, const std::vector<int>& rides,
+    LegalMoveCounter& counter) const {
+  return generateRides(board, origin, black, rides, counter, Piece::ALL_MOVES);
+}
+template <class Conditions>
+bool SpecialisedMoveFactory<Conditions>::generateHops(
+    const Board& board, int origin, bool black, const std::vector<int>& hops,
+    MoveList& moves, int stage) const {
+  MoveCollector collector(moves);
+  return generateHops(board, origin, black, hops, collector, stage);
+}
+template <class Conditions>
+bool SpecialisedMoveFactory<Conditions>::generateHops(
+    const Board& board, int origin, bool black, const std::vector<int>& hops,
+    LegalMoveCounter& counter) const {
+  return generateHops(board, origin, black, hops, counter, Piece::ALL_MOVES);
+}
+template <class Conditions>
+bool SpecialisedMoveFactory<Conditions>::generatePawnMoves(
+    const Board& board, const std::array<int, 20>& box,
+    const std::pair<int, int>& state, int origin, bool black, MoveList& moves,
+    int stage) const {
+  MoveCollector collector(moves);
+  return generatePawnMoves(board, box, state, origin, black, collector, stage);
+}
+template <class Conditions>
+bool SpecialisedMoveFactory<Conditions>::generatePawnMoves(
+    const Board& board, const std::array<int, 20>& box,
+    const std::pair<int, int>& state, int origin, bool black,
+    LegalMoveCounter& counter) const {
+  return generatePawnMoves(board, box, state, origin, black, counter,
+                           Piece::ALL_MOVES);
+}
+template <class Conditions>
+void SpecialisedMoveFactory<Conditions>::generateCastlings(
+    const Board& board, int castlings, int origin, MoveList& moves) const {
+  MoveCollector collector(moves);
+  generateCastlings(board, castlings, origin, collector);
+}
+template <class Conditions>
+bool SpecialisedMoveFactory<Conditions>::generateCastlings(
+    const Board& board, int castlings, int origin,
+    LegalMoveCounter& counter) const {
+  return generateCastlings<LegalMoveCounter>(board, castlings, origin,
+                                             counter);
+}
+
+template <class Conditions>
+bool SpecialisedMoveFactory<Conditions>::isAttacked(
+    const Board& board, const std::array<int, 20>& box, int square,
+    bool black) const {
+  return findAttacks(board, box, square, black, 1) > 0;
+}
+template <class Conditions>
+int SpecialisedMoveFactory<Conditions>::countAttacks(
+    const Board& board, const std::array<int, 20>& box, int square,
+    bool black) const {
+  return findAttacks(board, box, square, black, INT_MAX);
+}
+template <class Conditions>
+int SpecialisedMoveFactory<Conditions>::findAttacks(
+    const Board& board, const std::array<int, 20>& box, int square, bool black,
+    int limit) const {
+  int nAttacks = 0;
+  for (int direction : kingLeaps) {
+    int origin = square - direction;
+    if (!(origin & 136) &&
+        board.at(origin) == Board::toCode(Board::KING, black)) {
+      if (!this->generateCapture(board, origin, square) &&
+          ++nAttacks == limit) {
+        return nAttacks;
+      }
+    }
+  }
+  for (int direction : knightLeaps) {
+    int origin = square - direction;
+    if (!(origin & 136)) {
+      unsigned char code = board.at(origin);
+      if (code == Board::toCode(Board::KNIGHT, black) ||
+          code == Board::toCode(Board::AMAZON, black)) {
+        if (!this->generateCapture(board, origin, square) &&
+            ++nAttacks == limit) {
+          return nAttacks;
+        }
+      }
+    }
+  }
+  for (int direction : orthogonalRides) {
+    int origin = findRider(board, square, direction);
+    if (origin >= 0) {
+      unsigned char code = board.at(origin);
+      if (code == Board::toCode(Board::QUEEN, black) ||
+          code == Board::toCode(Board::ROOK, black) ||
+          code == Board::toCode(Board::AMAZON, black)) {
+        if (!this->generateCapture(board, origin, square) &&
+            ++nAttacks == limit) {
+          return nAttacks;
+        }
+      }
+    }
+  }
+  for (int direction : diagonalRides) {
+    int origin = findRider(board, square, direction);
+    if (origin >= 0) {
+      unsigned char code = board.at(origin);
+      if (code == Board::toCode(Board::QUEEN, black) ||
+          code == Board::toCode(Board::BISHOP, black) ||
+          code == Board::toCode(Board::AMAZON, black)) {
+        if (!this->generateCapture(board, origin, square) &&
+            ++nAttacks == limit) {
+          return nAttacks;
+        }
+      }
+    }
+  }
+  for (int direction : knightLeaps) {
+    int origin = findRider(board, square, direction);
+    if (origin >= 0 &&
+        board.at(origin) == Board::toCode(Board::NIGHTRIDER, black)) {
+      if (!this->generateCapture(board, origin, square) &&
+          ++nAttacks == limit) {
+        return nAttacks;
+      }
+    }
+  }
+  for (int direction : kingLeaps) {
+    int hurdle = square - direction;
+    if (!(hurdle & 136) && board.at(hurdle)) {
+      int origin = findRider(board, hurdle, direction);
+      if (origin >= 0 &&
+          board.at(origin) == Board::toCode(Board::GRASSHOPPER, black)) {
+        if (!this->generateCapture(board, origin, square) &&
+            ++nAttacks == limit) {
+          return nAttacks;
+        }
+      }
+    }
+  }
+  for (int direction : {black ? -17 : -15, black ? 15 : 17}) {
+    int origin = square - direction;
+    if (!(origin & 136) &&
+        board.at(origin) == Board::toCode(Board::PAWN, black)) {
+      bool attack = false;
+      if (origin % 16 == (black ? 1 : 6)) {
+        for (int type = Board::QUEEN; type <= Board::AMAZON; type++) {
+          if (box[Board::toCode(type, black)] &&
+              !this->generatePromotionCapture(board, origin, square, black,
+                                              type)) {
+            attack = true;
+            break;
+          }
+        }
+      } else {
+        attack = !this->generateCapture(board, origin, square);
+      }
+      if (attack && ++nAttacks == limit) {
+        return nAttacks;
+      }
+    }
+  }
+  return nAttacks;
+}
+template <class Conditions>
+bool SpecialisedMoveFactory<Conditions>::hasLocalMoves() const {
+  return std::is_same<Conditions, MoveFactory>::value ||
+         std::is_same<Conditions, NoCaptureMoveFactory>::value;
+}
+template <class Conditions>
+bool SpecialisedMoveFactory<Conditions>::hasLocalChecks() const {
+  return !std::is_base_of<AntiCirceMoveFactory, Conditions>::value;
+}
+template <class Conditions>
+std::unique_ptr<MoveFactory> SpecialisedMoveFactory<Conditions>::clone()
+    const {
+  return std::make_unique<SpecialisedMoveFactory>(*this);
+}
+
+template class SpecialisedMoveFactory<MoveFactory>;
+template class SpecialisedMoveFactory<NoCaptureMoveFactory>;
+template class SpecialisedMoveFactory<CirceMoveFactory>;
+template class SpecialisedMoveFactory<AntiCirceMoveFactory>;
+template class SpecialisedMoveFactory<AndernachMoveFactory>;
+template class SpecialisedMoveFactory<AntiAndernachMoveFactory>;
+template class SpecialisedMoveFactory<CirceAndernachMoveFactory>;
+template class SpecialisedMoveFactory<AntiCirceAndernachMoveFactory>;
+template class SpecialisedMoveFactory<NoCaptureAntiAndernachMoveFactory>;
+template class SpecialisedMoveFactory<CirceAntiAndernachMoveFactory>;
+template class SpecialisedMoveFactory<AntiCirceAntiAndernachMoveFactory>;
+
+}  // namespace moderato
@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024-2025 Ivan Denkovski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "FairyConditions.h"
+
+namespace moderato {
+
+template <class Conditions>
+class SpecialisedMoveFactory final : public Conditions {
+  int findAttacks(const Board& board, const std::array<int, 20>& box,
+                  int square, bool black, int limit) const;
+  template <class Sink>
+  bool generateLeaps(const Board& board, int origin, bool black,
+                     const std::vector<int>& leaps, Sink& sink,
+                     int stage) const;
+  template <class Sink>
+  bool generateRides(const Board& board, int origin, bool black,
+                     const std::vector<int>& rides, Sink& sink,
+                     int stage) const;
+  template <class Sink>
+  bool generateHops(const Board& board, int origin, bool black,
+                    const std::vector<int>& hops, Sink& sink, int stage) const;
+  template <class Sink>
+  bool generatePawnMoves(const Board& board, const std::array<int, 20>& box,
+                         const std::pair<int, int>& state, int origin,
+                         bool black, Sink& sink, int stage) const;
+  template <class Sink>
+  bool generateCastlings(const Board& board, int castlings, int origin,
+                         Sink& sink) const;
+
+ public:
+  using Conditions::Conditions;
+  bool generateLeaps(const Board& board, int origin, bool black,
+                     const std::vector<int>& leaps, MoveList& moves,
+                     int stage) const override;
+  bool generateLeaps(const Board& board, int origin, bool black,
+                     const std::vector<int>& leaps,
+                     LegalMoveCounter& counter) const override;
+  bool generateRides(const Board& board, int origin, bool black,
+                     const std::vector<int>& rides, MoveList& moves,
+                     int stage) const override;
+  bool generateRides(const Board& board, int origin, bool black,
+                     const std::vector<int>& rides,
+                     LegalMoveCounter& counter) const override;
+  bool generateHops(const Board& board, int origin, bool black,
+                    const std::vector<int>& hops, MoveList& moves,
+                    int stage) const override;
+  bool generateHops(const Board& board, int origin, bool black,
+                    const std::vector<int>& hops,
+                    LegalMoveCounter& counter) const override;
+  bool generatePawnMoves(const Board& board, const std::array<int, 20>& box,
+                         const std::pair<int, int>& state, int origin,
+                         bool black, MoveList& moves, int stage) const override;
+  bool generatePawnMoves(const Board& board, const std::array<int, 20>& box,
+                         const std::pair<int, int>& state, int origin,
+                         bool black, LegalMoveCounter& counter) const override;
+  void generateCastlings(const Board& board, int castlings, int origin,
+                         MoveList& moves) const override;
+  bool generateCastlings(const Board& board, int castlings, int origin,
+                         LegalMoveCounter& counter) const override;
+  bool isAttacked(const Board& board, const std::array<int, 20>& box,
+                  int square, bool black) const override;
+  int countAttacks(const Board& board, const std::array<int, 20>& box,
+                   int square, bool black) const override;
+  bool hasLocalMoves() const override;
+  bool hasLocalChecks() const override;
+  std::unique_ptr<MoveFactory> clone() const override;
+};
+
+}  // namespace moderato
@@ -0,0 +1,235 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Ivan Denkovski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "TranspositionTable.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <new>
+
+#include "Problem.h"
+
+namespace moderato {
+
+namespace {
+
+const std::uint64_t magic = 0x3254415245444F4D;
+
+std::uint64_t hashText(const std::string& text) {
+  std::uint64_t key = 0xCBF29CE484222325;
+  for (unsigned char character : text) {
+    key = (key ^ character) * 0x100000001B3;
+  }
+  return key;
+}
+// Scores live in the low 47 bits as a signed field; storeExact skips any
+// score outside [minScore, maxScore] rather than truncate it.
+const std::int64_t maxScore = (std::int64_t(1) << 46) - 1;
+const std::int64_t minScore = -maxScore - 1;
+std::uint64_t pack(long score, bool lowerBound, int depth,
+                   unsigned char generation) {
+  return (std::uint64_t(score) & 0x7FFFFFFFFFFF) |
+         std::uint64_t(lowerBound) << 47 | std::uint64_t(depth & 0xFF) << 48 |
+         std::uint64_t(generation) << 56;
+}
+long toScore(std::uint64_t data) {
+  return long(std::int64_t(data << 17) >> 17);
+}
+bool isLowerBound(std::uint64_t data) { return data >> 47 & 1; }
+int toDepth(std::uint64_t data) { return int(data >> 48 & 0xFF); }
+unsigned char toGeneration(std::uint64_t data) {
+  return static_cast<unsigned char>(data >> 56);
+}
+
+}  // namespace
+
+TranspositionTable::TranspositionTable(int hashSize,
+                                       const std::string& fileName,
+                                       const std::string& fingerprint)
+    : size_(2), generation_(0), nProbes_(0), nHits_(0), nCollisions_(0) {
+  std::uint64_t bytes =
+      std::min<std::uint64_t>(std::uint64_t(hashSize) << 20, SIZE_MAX / 2);
+  while (std::uint64_t(size_) * 2 * sizeof(Entry) <= bytes) {
+    size_ *= 2;
+  }
+  if (!fileName.empty()) {
+    file_ = std::make_unique<MappedFile>(
+        fileName, sizeof(Header) + size_ * sizeof(Entry), magic);
+    if (file_->getData()) {
+      header_ = static_cast<Header*>(file_->getData());
+      entries_ = reinterpret_cast<Entry*>(header_ + 1);
+      std::uint64_t key = hashText(fingerprint);
+      if (file_->isNew() || header_->fingerprint != key ||
+          header_->size != size_) {
+        for (std::size_t slot = 0; slot < size_; slot++) {
+          entries_[slot].check.store(0, std::memory_order_relaxed);
+          entries_[slot].data.store(0, std::memory_order_relaxed);
+        }
+        *header_ = {magic, key, size_, 0};
+      }
+      generation_ = static_cast<unsigned char>(header_->generation);
+    } else {
+      logger(std::clog) << "Map failure (invalid file: \"" << fileName
+                        << "\")." << std::endl;
+      file_.reset();
+    }
+  }
+  if (!entries_) {
+    std::size_t size = size_;
+    while (true) {
+      try {
+        std::vector<Entry>(size_).swap(storage_);
+        break;
+      } catch (const std::bad_alloc&) {
+        if (size_ == 2) {
+          throw;
+        }
+        size_ /= 2;
+      }
+    }
+    if (size_ < size) {
+      logger(std::clog) << "Allocation failure (hash size reduced to "
+                        << (std::uint64_t(size_) * sizeof(Entry) >> 20)
+                        << " MB)." << std::endl;
+    }
+    entries_ = storage_.data();
+  }
+  newSearch();
+}
+void TranspositionTable::newSearch() {
+  generation_ = generation_ % 255 + 1;
+  if (header_) {
+    header_->generation = generation_;
+  }
+}
+bool TranspositionTable::load(std::uint64_t key, int& depth, long& score,
+                              bool& lowerBound) {
+  nProbes_.fetch_add(1, std::memory_order_relaxed);
+  std::size_t index = key & (size_ - 2);
+  for (std::size_t slot = index; slot < index + 2; slot++) {
+    std::uint64_t data = entries_[slot].data.load(std::memory_order_relaxed);
+    std::uint64_t check = entries_[slot].check.load(std::memory_order_relaxed);
+    if ((check ^ data) == key) {
+      depth = toDepth(data);
+      score = toScore(data);
+      lowerBound = isLowerBound(data);
+      return true;
+    }
+  }
+  return false;
+}
+void TranspositionTable::save(std::uint64_t key, int depth, long score,
+                              bool lowerBound, bool exact) {
+  std::size_t index = key & (size_ - 2);
+  for (std::size_t slot = index; slot < index + 2; slot++) {
+    std::uint64_t data = entries_[slot].data.load(std::memory_order_relaxed);
+    std::uint64_t check = entries_[slot].check.load(std::memory_order_relaxed);
+    if ((check ^ data) == key) {
+      if (!exact && !isLowerBound(data) &&
+          (toScore(data) > 0 || (score == INT_MIN && toDepth(data) >= depth))) {
+        return;
+      }
+      write(slot, key, depth, score, lowerBound);
+      return;
+    }
+  }
+  std::uint64_t data = entries_[index].data.load(std::memory_order_relaxed);
+  if (toGeneration(data) == generation_ && toDepth(data) > depth) {
+    index++;
+    data = entries_[index].data.load(std::memory_order_relaxed);
+  }
+  if (toGeneration(data) == generation_) {
+    nCollisions_.fetch_add(1, std::memory_order_relaxed);
+  }
+  write(index, key, depth, score, lowerBound);
+}
+void TranspositionTable::write(std::size_t slot, std::uint64_t key, int depth,
+                               long score, bool lowerBound) {
+  std::uint64_t data = pack(score, lowerBound, depth, generation_);
+  entries_[slot].check.store(key ^ data, std::memory_order_relaxed);
+  entries_[slot].data.store(data, std::memory_order_relaxed);
+}
+bool TranspositionTable::probe(std::uint64_t key, int depth, int bound,
+                               int& score) {
+  int entryDepth;
+  long entryScore;
+  bool entryLowerBound;
+  if (load(key, entryDepth, entryScore, entryLowerBound)) {
+    if (entryScore > 0) {
+      int adjustedScore = int(entryScore) + depth - entryDepth;
+      if (!entryLowerBound) {
+        score = adjustedScore < 1 ? INT_MIN : adjustedScore;
+        nHits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+      if (adjustedScore >= bound && adjustedScore >= 1) {
+        score = adjustedScore;
+        nHits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+      return false;
+    }
+    if (entryScore == INT_MIN && entryDepth >= depth) {
+      score = INT_MIN;
+      nHits_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+bool TranspositionTable::probeExact(std::uint64_t key, int depth,
+                                    long& score) {
+  int entryDepth;
+  long entryScore;
+  bool entryLowerBound;
+  if (load(key, entryDepth, entryScore, entryLowerBound) &&
+      entryDepth == depth) {
+    score = entryScore;
+    nHits_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
+void TranspositionTable::store(std::uint64_t key, int depth, int score,
+                               bool lowerBound) {
+  save(key, depth, score, lowerBound, false);
+}
+void TranspositionTable::storeExact(std::uint64_t key, int depth, long score) {
+  if (score >= minScore && score <= maxScore) {
+    save(key, depth, score, false, true);
+  }
+}
+std::ostream& operator<<(std::ostream& output,
+                         const TranspositionTable& transpositionTable) {
+  output << "TranspositionTable[mapped=" << bool(transpositionTable.file_)
+         << ", size=" << transpositionTable.size_
+         << ", nProbes=" << transpositionTable.nProbes_
+         << ", nHits=" << transpositionTable.nHits_
+         << ", nCollisions=" << transpositionTable.nCollisions_ << "]";
+  return output;
+}
+
+}  // namespace moderato
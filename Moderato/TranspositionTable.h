@@ -0,0 +1,76 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Ivan Denkovski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+namespace moderato {
+
+class TranspositionTable {
+  struct Header {
+    std::uint64_t magic;
+    std::uint64_t fingerprint;
+    std::uint64_t size;
+    std::uint64_t generation;
+  };
+  struct Entry {
+    std::atomic<std::uint64_t> check;
+    std::atomic<std::uint64_t> data;
+  };
+  std::unique_ptr<MappedFile> file_;
+  Header* header_ = nullptr;
+  std::vector<Entry> storage_;
+  Entry* entries_ = nullptr;
+  std::size_t size_;
+  unsigned char generation_;
+  std::atomic<long> nProbes_;
+  std::atomic<long> nHits_;
+  std::atomic<long> nCollisions_;
+  bool load(std::uint64_t key, int& depth, long& score, bool& lowerBound);
+  void save(std::uint64_t key, int depth, long score, bool lowerBound,
+            bool exact);
+  void write(std::size_t slot, std::uint64_t key, int depth, long score,
+             bool lowerBound);
+
+ public:
+  TranspositionTable(int hashSize, const std::string& fileName,
+                     const std::string& fingerprint);
+  void newSearch();
+  bool probe(std::uint64_t key, int depth, int bound, int& score);
+  bool probeExact(std::uint64_t key, int depth, long& score);
+  void store(std::uint64_t key, int depth, int score, bool lowerBound);
+  void storeExact(std::uint64_t key, int depth, long score);
+  friend std::ostream& operator<<(std::ostream& output,
+                                  const TranspositionTable& transpositionTable);
+};
+
+}  // namespace moderato
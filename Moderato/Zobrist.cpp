@@ -0,0 +1,86 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Ivan Denkovski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Zobrist.h"
+
+#include <array>
+#include <random>
+
+namespace moderato {
+
+namespace {
+
+struct Keys {
+  std::array<std::array<std::uint64_t, 128>, 20> pieces;
+  std::array<std::uint64_t, 64> castlings;
+  std::array<std::uint64_t, 128> enPassants;
+  std::uint64_t side;
+  std::array<std::uint64_t, 20> boxes;
+};
+
+Keys generateKeys() {
+  std::mt19937_64 engine;
+  Keys keys;
+  for (std::array<std::uint64_t, 128>& squares : keys.pieces) {
+    for (std::uint64_t& key : squares) {
+      key = engine();
+    }
+  }
+  for (std::uint64_t& key : keys.castlings) {
+    key = engine();
+  }
+  for (std::uint64_t& key : keys.enPassants) {
+    key = engine();
+  }
+  keys.side = engine();
+  for (std::uint64_t& key : keys.boxes) {
+    key = engine();
+  }
+  return keys;
+}
+
+const Keys keys = generateKeys();
+
+}  // namespace
+
+std::uint64_t hashPiece(unsigned char code, int square) {
+  return keys.pieces[code][square];
+}
+std::uint64_t hashCastlings(int castlings) { return keys.castlings[castlings]; }
+std::uint64_t hashEnPassant(int square) {
+  return square < 0 ? 0 : keys.enPassants[square];
+}
+std::uint64_t hashSide() { return keys.side; }
+std::uint64_t hashState(const std::pair<int, int>& state) {
+  return hashCastlings(state.first) ^ hashEnPassant(state.second);
+}
+std::uint64_t hashBox(const std::array<int, 20>& box) {
+  std::uint64_t key = 0;
+  for (int code = 0; code < 20; code++) {
+    key ^= keys.boxes[code] * static_cast<std::uint64_t>(box[code]);
+  }
+  return key;
+}
+
+}  // namespace moderato